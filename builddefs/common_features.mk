@@ -250,6 +250,15 @@ else
   endif
 endif
 
+ifeq ($(strip $(EECONFIG_RECORDS_ENABLE)), yes)
+    OPT_DEFS += -DEECONFIG_RECORDS_ENABLE
+    CRC_ENABLE := yes
+endif
+
+ifeq ($(strip $(EEPROM_STATS_ENABLE)), yes)
+    OPT_DEFS += -DEEPROM_STATS_ENABLE
+endif
+
 VALID_WEAR_LEVELING_DRIVER_TYPES := custom embedded_flash spi_flash rp2040_flash legacy
 WEAR_LEVELING_DRIVER ?= none
 ifneq ($(strip $(WEAR_LEVELING_DRIVER)),none)
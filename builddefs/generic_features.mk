@@ -21,6 +21,7 @@ SPACE_CADET_ENABLE ?= yes
 GENERIC_FEATURES = \
     AUTO_SHIFT \
     AUTOCORRECT \
+    BOOT_PROFILE \
     CAPS_WORD \
     COMBO \
     COMMAND \
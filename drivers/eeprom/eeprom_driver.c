@@ -19,6 +19,85 @@
 
 #include "eeprom_driver.h"
 
+#ifdef EEPROM_STATS_ENABLE
+#    include "timer.h"
+#    include "util.h"
+#    include "eeconfig.h"
+#    ifdef VIA_ENABLE
+#        include "via.h"
+#    endif
+#    ifdef DYNAMIC_KEYMAP_ENABLE
+#        include "dynamic_keymap_eeprom.h"
+#    endif
+#    ifdef EEPROM_WEAR_LEVELING
+#        include "wear_leveling.h"
+#    endif
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} eeprom_region_range_t;
+
+// Address ranges of each region, taken from the layout macros of the features that own them
+static const eeprom_region_range_t eeprom_regions[EEPROM_REGION_OTHER] = {
+    [EEPROM_REGION_EECONFIG]       = {0, EECONFIG_BASE_SIZE},
+    [EEPROM_REGION_KB_DATABLOCK]   = {EECONFIG_BASE_SIZE, EECONFIG_BASE_SIZE + EECONFIG_RECORD_STORAGE_SIZE(EECONFIG_KB_DATA_SIZE)},
+    [EEPROM_REGION_USER_DATABLOCK] = {EECONFIG_BASE_SIZE + EECONFIG_RECORD_STORAGE_SIZE(EECONFIG_KB_DATA_SIZE), EECONFIG_SIZE},
+#    ifdef VIA_ENABLE
+    [EEPROM_REGION_VIA] = {VIA_EEPROM_MAGIC_ADDR, VIA_EEPROM_CONFIG_END},
+#    endif
+#    ifdef DYNAMIC_KEYMAP_ENABLE
+    [EEPROM_REGION_DYNAMIC_KEYMAP] = {DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR},
+    [EEPROM_REGION_MACROS]         = {DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR, DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE},
+#    endif
+};
+
+static eeprom_stats_t eeprom_stats;
+
+const eeprom_stats_t *eeprom_stats_get(void) {
+    return &eeprom_stats;
+}
+
+void eeprom_stats_reset(void) {
+    memset(&eeprom_stats, 0, sizeof(eeprom_stats));
+#    ifdef EEPROM_WEAR_LEVELING
+    wear_leveling_reset_stats();
+#    endif
+}
+
+// Splits an access across the regions it touches, anything outside of them is counted as other
+static void eeprom_stats_count(uint32_t *counters, const void *addr, size_t len) {
+    const uint32_t start   = (uintptr_t)addr;
+    const uint32_t end     = start + len;
+    uint32_t       counted = 0;
+    for (uint8_t i = 0; i < EEPROM_REGION_OTHER; i++) {
+        const uint32_t lo = MAX(start, eeprom_regions[i].start);
+        const uint32_t hi = MIN(end, eeprom_regions[i].end);
+        if (lo < hi) {
+            counters[i] += hi - lo;
+            counted += hi - lo;
+        }
+    }
+    counters[EEPROM_REGION_OTHER] += len - counted;
+}
+
+void eeprom_stats_read(const void *addr, size_t len) {
+    eeprom_stats_count(eeprom_stats.bytes_read, addr, len);
+}
+
+void eeprom_stats_write(const void *addr, size_t len) {
+    eeprom_stats_count(eeprom_stats.bytes_written, addr, len);
+}
+
+uint32_t eeprom_stats_begin(void) {
+    return timer_read32();
+}
+
+void eeprom_stats_blocked(uint32_t begin) {
+    eeprom_stats.blocked_ms += timer_elapsed32(begin);
+}
+#endif // EEPROM_STATS_ENABLE
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
@@ -52,9 +131,21 @@ void eeprom_write_dword(uint32_t *addr, uint32_t value) {
 void eeprom_update_block(const void *buf, void *addr, size_t len) {
     uint8_t read_buf[len];
     eeprom_read_block(read_buf, addr, len);
-    if (memcmp(buf, read_buf, len) != 0) {
-        eeprom_write_block(buf, addr, len);
+
+    // Only write the span between the first and last changed bytes, as backends like wear-leveling log every byte written
+    const uint8_t *p     = buf;
+    size_t         first = 0;
+    size_t         last  = len;
+    while (first < len && p[first] == read_buf[first]) {
+        first++;
+    }
+    if (first == len) {
+        return;
+    }
+    while (p[last - 1] == read_buf[last - 1]) {
+        last--;
     }
+    eeprom_write_block(p + first, (uint8_t *)addr + first, last - first);
 }
 
 void eeprom_update_byte(uint8_t *addr, uint8_t value) {
@@ -20,3 +20,37 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#ifdef EEPROM_STATS_ENABLE
+// Logical areas of the EEPROM that reads and writes are attributed to
+typedef enum {
+    EEPROM_REGION_EECONFIG,
+    EEPROM_REGION_KB_DATABLOCK,
+    EEPROM_REGION_USER_DATABLOCK,
+    EEPROM_REGION_VIA,
+    EEPROM_REGION_DYNAMIC_KEYMAP,
+    EEPROM_REGION_MACROS,
+    EEPROM_REGION_OTHER,
+    EEPROM_REGION_COUNT,
+} eeprom_region_t;
+
+typedef struct {
+    uint32_t bytes_read[EEPROM_REGION_COUNT];
+    uint32_t bytes_written[EEPROM_REGION_COUNT];
+    uint32_t blocked_ms; // time spent inside writes, erases and deferred flushes
+} eeprom_stats_t;
+
+const eeprom_stats_t *eeprom_stats_get(void);
+void                  eeprom_stats_reset(void);
+
+// Called by drivers to account for each access, and for the time spent in ones that block
+void     eeprom_stats_read(const void *addr, size_t len);
+void     eeprom_stats_write(const void *addr, size_t len);
+uint32_t eeprom_stats_begin(void);
+void     eeprom_stats_blocked(uint32_t begin);
+#else
+#    define eeprom_stats_read(addr, len)
+#    define eeprom_stats_write(addr, len)
+#    define eeprom_stats_begin() 0
+#    define eeprom_stats_blocked(begin) (void)(begin)
+#endif
@@ -35,7 +35,7 @@
 
 #include "wait.h"
 #include "i2c_master.h"
-#include "eeprom.h"
+#include "eeprom_driver.h"
 #include "eeprom_i2c.h"
 
 // #define DEBUG_EEPROM_OUTPUT
@@ -79,6 +79,7 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_stats_read(addr, len);
     uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
     fill_target_address(complete_packet, addr);
 
@@ -98,6 +99,8 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
     uint8_t * read_buf    = (uint8_t *)buf;
     uintptr_t target_addr = (uintptr_t)addr;
+    uint32_t  begin       = eeprom_stats_begin();
+    eeprom_stats_write(addr, len);
 
 #if defined(EXTERNAL_EEPROM_WP_PIN)
     setPinOutput(EXTERNAL_EEPROM_WP_PIN);
@@ -137,4 +140,5 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     writePin(EXTERNAL_EEPROM_WP_PIN, 1);
     setPinInputHigh(EXTERNAL_EEPROM_WP_PIN);
 #endif
+    eeprom_stats_blocked(begin);
 }
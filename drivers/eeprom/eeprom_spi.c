@@ -34,7 +34,7 @@
 #include "debug.h"
 #include "timer.h"
 #include "spi_master.h"
-#include "eeprom.h"
+#include "eeprom_driver.h"
 #include "eeprom_spi.h"
 
 #define CMD_WREN 6
@@ -109,6 +109,7 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_stats_read(addr, len);
     //-------------------------------------------------
     // Wait for the write-in-progress bit to be cleared
     spi_status_t response = spi_eeprom_wait_while_busy(EXTERNAL_EEPROM_SPI_TIMEOUT);
@@ -148,6 +149,7 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     bool      res;
     uint8_t * read_buf    = (uint8_t *)buf;
     uintptr_t target_addr = (uintptr_t)addr;
+    eeprom_stats_write(addr, len);
 
     while (len > 0) {
         uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
@@ -40,6 +40,7 @@ void eeprom_driver_erase(void) {
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
     intptr_t offset = (intptr_t)addr;
+    eeprom_stats_read(addr, len);
     memset(buf, 0x00, len);
     len = clamp_length(offset, len);
     if (len > 0) {
@@ -49,6 +50,7 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
     intptr_t offset = (intptr_t)addr;
+    eeprom_stats_write(addr, len);
     len             = clamp_length(offset, len);
     if (len > 0) {
         memcpy(&transientBuffer[offset], buf, len);
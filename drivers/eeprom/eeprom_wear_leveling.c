@@ -6,18 +6,140 @@
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
+#ifdef EEPROM_WRITE_BACK
+#    include "timer.h"
+#    include "keyboard.h"
+
+#    ifndef EEPROM_WRITE_BACK_IDLE_MS
+#        define EEPROM_WRITE_BACK_IDLE_MS 2000
+#    endif
+
+#    ifndef EEPROM_WRITE_BACK_RANGES
+#        define EEPROM_WRITE_BACK_RANGES 8
+#    endif
+
+// Logical ranges written to the wear-leveling cache but not yet appended to the write log, kept sorted and disjoint
+static wear_leveling_range_t dirty_ranges[EEPROM_WRITE_BACK_RANGES];
+static uint8_t               dirty_count = 0;
+static uint32_t              last_write  = 0;
+
+static void eeprom_write_back_mark(uint32_t address, uint32_t length) {
+    uint32_t end = address + length;
+
+    // Absorb every range that overlaps or touches the new one
+    uint8_t first = 0;
+    while (first < dirty_count && dirty_ranges[first].address + dirty_ranges[first].length < address) {
+        first++;
+    }
+    uint8_t last = first;
+    while (last < dirty_count && dirty_ranges[last].address <= end) {
+        if (dirty_ranges[last].address < address) {
+            address = dirty_ranges[last].address;
+        }
+        if (dirty_ranges[last].address + dirty_ranges[last].length > end) {
+            end = dirty_ranges[last].address + dirty_ranges[last].length;
+        }
+        last++;
+    }
+
+    if (first == last) {
+        if (dirty_count == EEPROM_WRITE_BACK_RANGES) {
+            // Table is full, widen whichever neighbour leaves the smaller gap to cover the new range
+            bool use_prev = first == dirty_count || (first > 0 && address - (dirty_ranges[first - 1].address + dirty_ranges[first - 1].length) < dirty_ranges[first].address - end);
+            if (use_prev) {
+                first--;
+                address = dirty_ranges[first].address;
+            } else {
+                end = dirty_ranges[first].address + dirty_ranges[first].length;
+            }
+            last = first + 1;
+        } else {
+            memmove(&dirty_ranges[first + 1], &dirty_ranges[first], (dirty_count - first) * sizeof(wear_leveling_range_t));
+            dirty_count++;
+            last = first + 1;
+        }
+    } else if (last - first > 1) {
+        memmove(&dirty_ranges[first + 1], &dirty_ranges[last], (dirty_count - last) * sizeof(wear_leveling_range_t));
+        dirty_count -= last - first - 1;
+    }
+
+    dirty_ranges[first].address = address;
+    dirty_ranges[first].length  = end - address;
+    last_write                  = timer_read32();
+}
+
+void eeprom_sync(void) {
+    if (dirty_count == 0) {
+        return;
+    }
+    uint32_t begin = eeprom_stats_begin();
+    if (wear_leveling_commit(dirty_ranges, dirty_count) != WEAR_LEVELING_FAILED) {
+        dirty_count = 0;
+    } else {
+        // Keep the ranges for the next sync, and give the backing store an idle period before retrying
+        last_write = timer_read32();
+    }
+    eeprom_stats_blocked(begin);
+}
+#endif // EEPROM_WRITE_BACK
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+#    include "keyboard.h"
+
+#    ifndef WEAR_LEVELING_BACKGROUND_IDLE_MS
+#        define WEAR_LEVELING_BACKGROUND_IDLE_MS 250
+#    endif
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
+#if defined(EEPROM_WRITE_BACK) || defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+void eeprom_task(void) {
+#    ifdef EEPROM_WRITE_BACK
+    // Hold off while the keyboard is in use, a consolidation may stall the MCU for a flash erase
+    if (dirty_count > 0 && timer_elapsed32(last_write) >= EEPROM_WRITE_BACK_IDLE_MS && last_input_activity_elapsed() >= EEPROM_WRITE_BACK_IDLE_MS) {
+        eeprom_sync();
+    }
+#    endif // EEPROM_WRITE_BACK
+#    ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Each step is bounded, but erasing the spare bank still stalls flash access so wait for a pause in typing
+    if (last_input_activity_elapsed() >= WEAR_LEVELING_BACKGROUND_IDLE_MS) {
+        uint32_t begin = eeprom_stats_begin();
+        wear_leveling_task();
+        eeprom_stats_blocked(begin);
+    }
+#    endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+}
+#endif
+
 void eeprom_driver_init(void) {
     wear_leveling_init();
+#ifdef EEPROM_WRITE_BACK
+    dirty_count = 0;
+#endif
 }
 
 void eeprom_driver_erase(void) {
+    uint32_t begin = eeprom_stats_begin();
     wear_leveling_erase();
+    eeprom_stats_blocked(begin);
+#ifdef EEPROM_WRITE_BACK
+    dirty_count = 0;
+#endif
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
     wear_leveling_read((uint32_t)addr, buf, len);
+    eeprom_stats_read(addr, len);
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    uint32_t begin = eeprom_stats_begin();
+#ifdef EEPROM_WRITE_BACK
+    if (wear_leveling_write_cached((uint32_t)addr, buf, len) == WEAR_LEVELING_SUCCESS) {
+        eeprom_write_back_mark((uint32_t)addr, len);
+    }
+#else
     wear_leveling_write((uint32_t)addr, buf, len);
+#endif
+    eeprom_stats_write(addr, len);
+    eeprom_stats_blocked(begin);
 }
@@ -264,6 +264,14 @@ void is31fl3733_update_led_control_registers(uint8_t addr, uint8_t index) {
     }
 }
 
+void is31fl3733_update_global_current(uint8_t addr, uint8_t brightness) {
+    // Firstly we need to unlock the command register and select PG3.
+    is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
+    is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND, IS31FL3733_COMMAND_FUNCTION);
+    // Scale the configured current so that full brightness matches IS31FL3733_GLOBAL_CURRENT.
+    is31fl3733_write_register(addr, IS31FL3733_FUNCTION_REG_GLOBAL_CURRENT, ((uint16_t)IS31FL3733_GLOBAL_CURRENT * (brightness + 1)) >> 8);
+}
+
 void is31fl3733_flush(void) {
     is31fl3733_update_pwm_buffers(IS31FL3733_I2C_ADDRESS_1, 0);
 #if defined(IS31FL3733_I2C_ADDRESS_2)
@@ -276,3 +284,16 @@ void is31fl3733_flush(void) {
 #    endif
 #endif
 }
+
+void is31fl3733_set_global_brightness(uint8_t brightness) {
+    is31fl3733_update_global_current(IS31FL3733_I2C_ADDRESS_1, brightness);
+#if defined(IS31FL3733_I2C_ADDRESS_2)
+    is31fl3733_update_global_current(IS31FL3733_I2C_ADDRESS_2, brightness);
+#    if defined(IS31FL3733_I2C_ADDRESS_3)
+    is31fl3733_update_global_current(IS31FL3733_I2C_ADDRESS_3, brightness);
+#        if defined(IS31FL3733_I2C_ADDRESS_4)
+    is31fl3733_update_global_current(IS31FL3733_I2C_ADDRESS_4, brightness);
+#        endif
+#    endif
+#endif
+}
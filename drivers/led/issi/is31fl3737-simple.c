@@ -235,6 +235,14 @@ void is31fl3737_update_led_control_registers(uint8_t addr, uint8_t index) {
     }
 }
 
+void is31fl3737_update_global_current(uint8_t addr, uint8_t brightness) {
+    // Firstly we need to unlock the command register and select PG3.
+    is31fl3737_write_register(addr, IS31FL3737_REG_COMMAND_WRITE_LOCK, IS31FL3737_COMMAND_WRITE_LOCK_MAGIC);
+    is31fl3737_write_register(addr, IS31FL3737_REG_COMMAND, IS31FL3737_COMMAND_FUNCTION);
+    // Scale the configured current so that full brightness matches IS31FL3737_GLOBAL_CURRENT.
+    is31fl3737_write_register(addr, IS31FL3737_FUNCTION_REG_GLOBAL_CURRENT, ((uint16_t)IS31FL3737_GLOBAL_CURRENT * (brightness + 1)) >> 8);
+}
+
 void is31fl3737_flush(void) {
     is31fl3737_update_pwm_buffers(IS31FL3737_I2C_ADDRESS_1, 0);
 #if defined(IS31FL3737_I2C_ADDRESS_2)
@@ -247,3 +255,16 @@ void is31fl3737_flush(void) {
 #    endif
 #endif
 }
+
+void is31fl3737_set_global_brightness(uint8_t brightness) {
+    is31fl3737_update_global_current(IS31FL3737_I2C_ADDRESS_1, brightness);
+#if defined(IS31FL3737_I2C_ADDRESS_2)
+    is31fl3737_update_global_current(IS31FL3737_I2C_ADDRESS_2, brightness);
+#    if defined(IS31FL3737_I2C_ADDRESS_3)
+    is31fl3737_update_global_current(IS31FL3737_I2C_ADDRESS_3, brightness);
+#        if defined(IS31FL3737_I2C_ADDRESS_4)
+    is31fl3737_update_global_current(IS31FL3737_I2C_ADDRESS_4, brightness);
+#        endif
+#    endif
+#endif
+}
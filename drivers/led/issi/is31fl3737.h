@@ -132,8 +132,10 @@ void is31fl3737_set_led_control_register(uint8_t index, bool red, bool green, bo
 // If the buffer is dirty, it will update the driver with the buffer.
 void is31fl3737_update_pwm_buffers(uint8_t addr, uint8_t index);
 void is31fl3737_update_led_control_registers(uint8_t addr, uint8_t index);
+void is31fl3737_update_global_current(uint8_t addr, uint8_t brightness);
 
 void is31fl3737_flush(void);
+void is31fl3737_set_global_brightness(uint8_t brightness);
 
 #define IS31FL3737_PDR_0_OHM 0b000   // No pull-down resistor
 #define IS31FL3737_PDR_0K5_OHM 0b001 // 0.5 kOhm resistor
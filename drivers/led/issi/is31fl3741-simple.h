@@ -117,11 +117,13 @@ void is31fl3741_set_led_control_register(uint8_t index, bool value);
 // If the buffer is dirty, it will update the driver with the buffer.
 void is31fl3741_update_pwm_buffers(uint8_t addr, uint8_t index);
 void is31fl3741_update_led_control_registers(uint8_t addr, uint8_t index);
+void is31fl3741_update_global_current(uint8_t addr, uint8_t brightness);
 void is31fl3741_set_scaling_registers(const is31fl3741_led_t *pled, uint8_t value);
 
 void is31fl3741_set_pwm_buffer(const is31fl3741_led *pled, uint8_t value);
 
 void is31fl3741_flush(void);
+void is31fl3741_set_global_brightness(uint8_t brightness);
 
 #define IS31FL3741_PDR_0_OHM 0b000   // No pull-down resistor
 #define IS31FL3741_PDR_0K5_OHM 0b001 // 0.5 kOhm resistor
@@ -197,11 +197,25 @@ void snled27351_update_led_control_registers(uint8_t index) {
     g_led_control_registers_update_required[index] = false;
 }
 
+void snled27351_update_current_tune(uint8_t index, uint8_t brightness) {
+    uint8_t current_tune_reg[LED_CURRENT_TUNE_LENGTH] = SNLED27351_CURRENT_TUNE;
+    // Scale the configured current so that full brightness matches SNLED27351_CURRENT_TUNE
+    for (uint8_t i = 0; i < LED_CURRENT_TUNE_LENGTH; i++) {
+        current_tune_reg[i] = ((uint16_t)current_tune_reg[i] * (brightness + 1)) >> 8;
+    }
+    snled27351_write(index, CURRENT_TUNE_PAGE, 0, current_tune_reg, LED_CURRENT_TUNE_LENGTH);
+}
+
 void snled27351_flush(void) {
     for (uint8_t i = 0; i < SNLED27351_DRIVER_COUNT; i++)
         snled27351_update_pwm_buffers(i);
 }
 
+void snled27351_set_global_brightness(uint8_t brightness) {
+    for (uint8_t i = 0; i < SNLED27351_DRIVER_COUNT; i++)
+        snled27351_update_current_tune(i, brightness);
+}
+
 void snled27351_shutdown(void) {
 #    if defined(LED_DRIVER_SHUTDOWN_PIN)
     writePinLow(LED_DRIVER_SHUTDOWN_PIN);
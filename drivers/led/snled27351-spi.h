@@ -51,7 +51,9 @@ void snled27351_set_led_control_register(uint8_t index, bool red, bool green, bo
 // If the buffer is dirty, it will update the driver with the buffer.
 void snled27351_update_pwm_buffers(uint8_t index);
 void snled27351_update_led_control_registers(uint8_t index);
+void snled27351_update_current_tune(uint8_t index, uint8_t brightness);
 void snled27351_flush(void);
+void snled27351_set_global_brightness(uint8_t brightness);
 void snled27351_shutdown(void);
 void snled27351_exit_shutdown(void);
 void snled27351_sw_return_normal(uint8_t index);
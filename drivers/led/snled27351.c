@@ -252,6 +252,15 @@ void snled27351_update_led_control_registers(uint8_t addr, uint8_t index) {
     g_led_control_registers_update_required[index] = false;
 }
 
+void snled27351_update_current_tune(uint8_t addr, uint8_t brightness) {
+    uint8_t current_tune_reg_list[SNLED27351_LED_CURRENT_TUNE_LENGTH] = SNLED27351_CURRENT_TUNE;
+    snled27351_write_register(addr, SNLED27351_REG_COMMAND, SNLED27351_COMMAND_CURRENT_TUNE);
+    for (int i = 0; i < SNLED27351_LED_CURRENT_TUNE_LENGTH; i++) {
+        // Scale the configured current so that full brightness matches SNLED27351_CURRENT_TUNE
+        snled27351_write_register(addr, i, ((uint16_t)current_tune_reg_list[i] * (brightness + 1)) >> 8);
+    }
+}
+
 void snled27351_flush(void) {
     snled27351_update_pwm_buffers(SNLED27351_I2C_ADDRESS_1, 0);
 #if defined(SNLED27351_I2C_ADDRESS_2)
@@ -265,6 +274,19 @@ void snled27351_flush(void) {
 #endif
 }
 
+void snled27351_set_global_brightness(uint8_t brightness) {
+    snled27351_update_current_tune(SNLED27351_I2C_ADDRESS_1, brightness);
+#if defined(SNLED27351_I2C_ADDRESS_2)
+    snled27351_update_current_tune(SNLED27351_I2C_ADDRESS_2, brightness);
+#    if defined(SNLED27351_I2C_ADDRESS_3)
+    snled27351_update_current_tune(SNLED27351_I2C_ADDRESS_3, brightness);
+#        if defined(SNLED27351_I2C_ADDRESS_4)
+    snled27351_update_current_tune(SNLED27351_I2C_ADDRESS_4, brightness);
+#        endif
+#    endif
+#endif
+}
+
 void snled27351_shutdown(void) {
 #    if defined(LED_DRIVER_SHUTDOWN_PIN)
     writePinLow(LED_DRIVER_SHUTDOWN_PIN);
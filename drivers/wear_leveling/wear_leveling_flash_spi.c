@@ -41,6 +41,28 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+bool backing_store_erase_bank(uint8_t bank) {
+    _Static_assert((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT) % 2 == 0, "Background consolidation requires an even number of external flash blocks");
+
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    bool ret = true;
+    for (int i = 0; i < (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT) / 2; ++i) {
+        flash_status_t status = flash_erase_block(((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) + bank * ((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT) / 2) + i) * (EXTERNAL_FLASH_BLOCK_SIZE));
+        if (status != FLASH_STATUS_SUCCESS) {
+            ret = false;
+            break;
+        }
+    }
+
+    bs_dprintf("Backing store bank %d erase took %ldms to complete\n", (int)bank, ((long)(timer_read32() - start)));
+    return ret;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -170,6 +170,81 @@ void get_support_feature(uint8_t *data) {
         ;
 }
 
+#ifdef BOOT_PROFILE_ENABLE
+// data[1]: 0 for the current profile, 1 for the one before it
+void get_boot_profile(uint8_t *data, uint8_t length) {
+    const boot_profile_t *profile = boot_profile_get(data[1]);
+    if (profile == NULL || length < 9 + BOOT_PHASE_COUNT * 2) {
+        data[1] = 0xFF;
+        return;
+    }
+
+    uint8_t i = 1;
+    data[i++] = 0;
+    data[i++] = profile->reason;
+    data[i++] = profile->recorded & 0xFF;
+    data[i++] = profile->recorded >> 8;
+    for (uint8_t shift = 0; shift < 32; shift += 8) {
+        data[i++] = (profile->start >> shift) & 0xFF;
+    }
+    for (uint8_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        data[i++] = profile->elapsed[phase] & 0xFF;
+        data[i++] = profile->elapsed[phase] >> 8;
+    }
+}
+#endif
+
+#ifdef EEPROM_STATS_ENABLE
+#    include "eeprom_driver.h"
+#    ifdef EEPROM_WEAR_LEVELING
+#        include "wear_leveling.h"
+#    endif
+
+enum { eeprom_stats_region = 0x00, eeprom_stats_summary = 0x01, eeprom_stats_reset_all = 0x02 };
+
+static uint8_t put_u32(uint8_t *data, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        data[i] = (value >> (i * 8)) & 0xFF;
+    }
+    return 4;
+}
+
+// data[1]: sub command, data[2]: region for eeprom_stats_region
+void get_eeprom_stats(uint8_t *data) {
+    const eeprom_stats_t *stats = eeprom_stats_get();
+    uint8_t               i     = 2;
+    switch (data[1]) {
+        case eeprom_stats_region:
+            if (data[2] >= EEPROM_REGION_COUNT) {
+                data[1] = 0xFF;
+                return;
+            }
+            i++;
+            i += put_u32(&data[i], stats->bytes_read[data[2]]);
+            i += put_u32(&data[i], stats->bytes_written[data[2]]);
+            break;
+
+        case eeprom_stats_summary: {
+            i += put_u32(&data[i], stats->blocked_ms);
+#    ifdef EEPROM_WEAR_LEVELING
+            const wear_leveling_stats_t *wl_stats = wear_leveling_get_stats();
+            i += put_u32(&data[i], wl_stats->appends);
+            i += put_u32(&data[i], wl_stats->consolidations);
+            i += put_u32(&data[i], wl_stats->erases);
+#    endif
+        } break;
+
+        case eeprom_stats_reset_all:
+            eeprom_stats_reset();
+            break;
+
+        default:
+            data[1] = 0xFF;
+            break;
+    }
+}
+#endif
+
 bool kc_raw_hid_rx(uint8_t *data, uint8_t length) {
     // if (!raw_hid_receive_keychron(data, length))
     //     return false;
@@ -218,6 +293,18 @@ bool kc_raw_hid_rx(uint8_t *data, uint8_t length) {
         case 0xAB:
             factory_test_rx(data, length);
             break;
+#endif
+#ifdef BOOT_PROFILE_ENABLE
+        case 0xAC:
+            get_boot_profile(data, length);
+            raw_hid_send(data, length);
+            break;
+#endif
+#ifdef EEPROM_STATS_ENABLE
+        case 0xAD:
+            get_eeprom_stats(data);
+            raw_hid_send(data, length);
+            break;
 #endif
         default:
             return false;
@@ -121,6 +121,8 @@ static pin_t p24g_led_pin_list[P24G_HOST_DEVICES_COUNT] = P24G_HOST_LED_PIN_LIST
 #    define LED_DRIVER_DISABLE_TIMEOUT_SET led_matrix_disable_timeout_set
 #    define LED_DRIVER_DISABLE_TIME_RESET led_matrix_disable_time_reset
 #    define LED_DRIVER_TIMEOUTED led_matrix_timeouted
+#    define LED_DRIVER_GLOBAL_BRIGHTNESS_KB led_matrix_driver_global_brightness_kb
+#    define LED_DRIVER_GLOBAL_BRIGHTNESS_USER led_matrix_driver_global_brightness_user
 #endif
 
 #ifdef RGB_MATRIX_ENABLE
@@ -148,6 +150,8 @@ static pin_t p24g_led_pin_list[P24G_HOST_DEVICES_COUNT] = P24G_HOST_LED_PIN_LIST
 #    define LED_DRIVER_DISABLE_TIMEOUT_SET rgb_matrix_disable_timeout_set
 #    define LED_DRIVER_DISABLE_TIME_RESET rgb_matrix_disable_time_reset
 #    define LED_DRIVER_TIMEOUTED rgb_matrix_timeouted
+#    define LED_DRIVER_GLOBAL_BRIGHTNESS_KB rgb_matrix_driver_global_brightness_kb
+#    define LED_DRIVER_GLOBAL_BRIGHTNESS_USER rgb_matrix_driver_global_brightness_user
 #endif
 
 bool LED_INDICATORS_KB(void);
@@ -648,7 +652,9 @@ bool LED_INDICATORS_KB(void) {
     if (get_transport() & TRANSPORT_WIRELESS) {
         /* Prevent backlight flash caused by key activities */
         if (battery_is_critical_low()) {
+#    if !defined(LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE) && !defined(RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE)
             SET_ALL_LED_OFF();
+#    endif
             return true;
         }
 
@@ -734,6 +740,15 @@ bool led_update_kb(led_t led_state) {
     return res;
 }
 
+#    if defined(LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE) || defined(RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE)
+uint8_t LED_DRIVER_GLOBAL_BRIGHTNESS_KB(uint8_t brightness) {
+    /* Blank the backlight with a single driver write instead of clearing every LED each frame */
+    if ((get_transport() & TRANSPORT_WIRELESS) && battery_is_critical_low()) return 0;
+
+    return LED_DRIVER_GLOBAL_BRIGHTNESS_USER(brightness);
+}
+
+#    endif
 void LED_NONE_INDICATORS_KB(void) {
 #    if defined(RGB_DISABLE_WHEN_USB_SUSPENDED) || defined(LED_DISABLE_WHEN_USB_SUSPENDED)
     if (get_transport() == TRANSPORT_USB && USB_DRIVER.state == USB_SUSPENDED) return;
@@ -193,13 +193,21 @@ static inline void lpm_wakeup(void) {
 #endif
 
     halInit();
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_start(BOOT_REASON_WAKE);
+#endif
 
 #ifdef ENCODER_ENABLE
     encoder_cb_init();
 #endif
 
     if (wireless_transport.init) wireless_transport.init(true);
-    battery_init();
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_KB_0);
+#endif
+    // Battery sensing was stopped for low power mode, restart it once the wake key is out
+    keyboard_deferred_init_wait();
+    wireless_defer_battery_init();
 
     /* Disable all wake up pins */
     for (uint8_t x = 0; x < MATRIX_ROWS; x++) {
@@ -236,6 +244,9 @@ static inline void lpm_wakeup(void) {
     invoked in matrix_init() alloc new memory to debounce_counters */
     debounce_free();
     matrix_init();
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_MATRIX_READY);
+#endif
 }
 
 void lpm_task(void) {
@@ -264,6 +275,8 @@ void lpm_task(void) {
 #endif
         {
             if (!lpm_any_matrix_action()) {
+                // Persist any deferred EEPROM writes before the MCU stops
+                eeprom_sync();
                 if (pre_enter_low_power_mode(LOW_POWER_MODE)) {
                     enter_power_mode(LOW_POWER_MODE);
 
@@ -39,6 +39,16 @@ static wt_state_t wireless_state           = WT_RESET;
 static bool       pincodeEntry             = false;
 uint8_t           wireless_report_protocol = true;
 
+#ifdef KEYBOARD_DEFERRED_INIT
+enum {
+    DEFERRED_INDICATOR = 1 << 0,
+    DEFERRED_BATTERY   = 1 << 1,
+};
+
+// Work held back until the matrix settles, so a wake keypress is sent first
+static uint8_t deferred_init = 0;
+#endif
+
 /* declarations */
 uint8_t wreless_keyboard_leds(void);
 void    wireless_send_keyboard(report_keyboard_t *report);
@@ -92,12 +102,18 @@ void wireless_init(void) {
 #ifndef DISABLE_REPORT_BUFFER
     report_buffer_init();
 #endif
+#ifdef KEYBOARD_DEFERRED_INIT
+    deferred_init = DEFERRED_INDICATOR | DEFERRED_BATTERY;
+#else
     indicator_init();
+#endif
 #ifdef BLUETOOTH_INT_INPUT_PIN
     setPinInputHigh(BLUETOOTH_INT_INPUT_PIN);
 #endif
 
+#ifndef KEYBOARD_DEFERRED_INIT
     battery_init();
+#endif
     lpm_init();
 #if HAL_USE_RTC
     rtc_timer_init();
@@ -502,11 +518,30 @@ void wireless_event_task(void) {
     }
 }
 
+void wireless_defer_battery_init(void) {
+#ifdef KEYBOARD_DEFERRED_INIT
+    deferred_init |= DEFERRED_BATTERY;
+#else
+    battery_init();
+#endif
+}
+
 void wireless_task(void) {
     wireless_transport.task();
     wireless_event_task();
 #ifndef DISABLE_REPORT_BUFFER
     report_buffer_task();
+#endif
+#ifdef KEYBOARD_DEFERRED_INIT
+    if (deferred_init && keyboard_deferred_init_ready()) {
+        // The wake key has been reported, and handed to the transport above
+        if (deferred_init & DEFERRED_INDICATOR) indicator_init();
+        if (deferred_init & DEFERRED_BATTERY) battery_init();
+        deferred_init = 0;
+#    ifdef BOOT_PROFILE_ENABLE
+        boot_profile_mark(BOOT_PHASE_KB_2);
+#    endif
+    }
 #endif
     indicator_task();
     keychron_wireless_common_task();
@@ -522,6 +557,16 @@ void send_string_task(void) {
 #endif
     }
 }
+bool send_string_transport_ready(void) {
+#ifndef DISABLE_REPORT_BUFFER
+    // Hold back until the previous report has gone out over the air
+    if ((get_transport() & TRANSPORT_WIRELESS) && wireless_get_state() == WT_CONNECTED) {
+        return report_buffer_is_empty();
+    }
+#endif
+    return true;
+}
+
 wt_state_t wireless_get_state(void) {
     return wireless_state;
 };
@@ -90,6 +90,7 @@ void wireless_exit_bluetooth_pin_code_entry_kb(void);
 void wireless_enter_sleep_kb(void);
 
 void wireless_task(void);
+void wireless_defer_battery_init(void);
 void wireless_pre_task(void);
 void wireless_post_task(void);
 void send_string_task(void);
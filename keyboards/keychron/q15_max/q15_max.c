@@ -44,7 +44,13 @@ void keyboard_post_init_kb(void) {
     palSetLineMode(BT_MODE_SELECT_PIN, PAL_MODE_INPUT);
 
     lkbt51_init(false);
+#    ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_KB_0);
+#    endif
     wireless_init();
+#    ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_KB_1);
+#    endif
 #endif
 
 #ifdef ENCODER_ENABLE
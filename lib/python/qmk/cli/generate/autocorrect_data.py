@@ -13,7 +13,8 @@
 # limitations under the License.
 """Python program to make autocorrect_data.h.
 This program reads from a prepared dictionary file and generates a C source file
-"autocorrect_data.h" with a serialized trie embedded as an array. Run this
+"autocorrect_data.h" with a serialized Aho-Corasick automaton embedded as an
+array. Run this
 program and pass it as the first argument like:
 $ qmk generate-autocorrect-data autocorrect_dict.txt
 Each line of the dict file defines one typo and its correction with the syntax
@@ -48,6 +49,7 @@ TYPO_CHARS = dict([
     (':', KC_SPC),  # "Word break" character.
 ] + [(chr(c), c + KC_A - ord('a')) for c in range(ord('a'),
                                                   ord('z') + 1)])  # Characters a-z.
+FAIL_LINK = 63  # Not a typo character, marks a node's failure link.
 
 
 def parse_file(file_name: str) -> List[Tuple[str, str]]:
@@ -107,23 +109,6 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
     return autocorrections
 
 
-def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
-    """Makes a trie from the the typos, writing in reverse.
-  Args:
-    autocorrections: List of (typo, correction) tuples.
-  Returns:
-    Dict of dict, representing the trie.
-  """
-    trie = {}
-    for typo, correction in autocorrections:
-        node = trie
-        for letter in typo[::-1]:
-            node = node.setdefault(letter, {})
-        node['LEAF'] = (typo, correction)
-
-    return trie
-
-
 def parse_file_lines(file_name: str) -> Iterator[Tuple[int, str, str]]:
     """Parses lines read from `file_name` into typo-correction pairs."""
 
@@ -165,20 +150,53 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
-    """Serializes trie and correction data in a form readable by the C code.
+def make_automaton(autocorrections: List[Tuple[str, str]]) -> List[Dict[str, Any]]:
+    """Makes an Aho-Corasick automaton from the typos.
+  The typos are inserted into a trie read forwards, and each node gets a
+  failure link to the node for its longest proper suffix that is also in the
+  trie. A node only stores its trie children, which are exactly the
+  transitions that differ from its failure node's; the firmware follows
+  failure links for every other keystroke. Most failure links lead to the
+  root's child for the node's last letter, so only the others are stored.
   Args:
     autocorrections: List of (typo, correction) tuples.
-    trie: Dict of dicts.
+  Returns:
+    List of nodes in breadth first order, root first.
+  """
+    root = {'children': {}, 'leaf': None, 'fail': None, 'depth': 0}
+    for typo, correction in autocorrections:
+        node = root
+        for letter in typo:
+            node = node['children'].setdefault(letter, {'children': {}, 'leaf': None, 'fail': root, 'depth': node['depth'] + 1})
+        node['leaf'] = (typo, correction)
+
+    nodes = [root]
+    for node in nodes:  # Breadth first, so shallower failure links are complete.
+        for letter, child in node['children'].items():
+            if node is not root:
+                fail = node['fail']
+                while letter not in fail['children'] and fail is not root:
+                    fail = fail['fail']
+                child['fail'] = fail['children'].get(letter, root)
+            nodes.append(child)
+
+    return nodes
+
+
+def serialize_automaton(nodes: List[Dict[str, Any]]) -> List[int]:
+    """Serializes the automaton in a form readable by the C code.
+  Args:
+    nodes: List of automaton nodes, root first.
   Returns:
     List of ints in the range 0-255.
   """
     table = []
 
-    # Traverse trie in depth first order.
-    def traverse(trie_node):
-        if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
+    # Lay nodes out depth first so one child of each node directly follows it.
+    def traverse(node):
+        node['byte_offset'] = 0
+        if node['leaf'] is not None:  # Handle a typo node.
+            typo, correction = node['leaf']
             word_boundary_ending = typo[-1] == ':'
             typo = typo.strip(':')
             i = 0  # Make the autocorrection data for this entry and serialize it.
@@ -187,49 +205,36 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
             backspaces = len(typo) - i - 1 + word_boundary_ending
             assert 0 <= backspaces <= 63
             correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
-            table.append(entry)
-        elif len(trie_node) == 1:  # Handle trie node with a single child.
-            c, trie_node = next(iter(trie_node.items()))
-            entry = {'chars': c, 'byte_offset': 0}
-
-            # It's common for a trie to have long chains of single-child nodes. We
-            # find the whole chain so that we can serialize it more efficiently.
-            while len(trie_node) == 1 and 'LEAF' not in trie_node:
-                c, trie_node = next(iter(trie_node.items()))
-                entry['chars'] += c
-
-            table.append(entry)
-            entry['links'] = [traverse(trie_node)]
-        else:  # Handle trie node with multiple children.
-            entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
-            table.append(entry)
-            entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
-        return entry
-
-    traverse(trie)
-
-    def serialize(e: Dict[str, Any]) -> List[int]:
-        if not e['links']:  # Handle a leaf table entry.
-            return e['data']
-        elif len(e['links']) == 1:  # Handle a chain table entry.
-            return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
-        else:  # Handle a branch table entry.
-            data = []
-            for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
+            node['data'] = [backspaces + 128] + list(bytes(correction, 'ascii')) + [0]
+            table.append(node)
+            return
+
+        table.append(node)
+        for child in node['children'].values():
+            traverse(child)
+
+    traverse(nodes[0])
+
+    def serialize(node: Dict[str, Any]) -> List[int]:
+        if node['leaf'] is not None:  # Handle a typo node.
+            return node['data']
+        data = []
+        if node['fail'] is not None and node['fail']['depth'] > 1:  # Shallower failure links are implied.
+            data += [FAIL_LINK] + encode_link(node['fail'])
+        children = list(node['children'].items())
+        for c, child in children[1:]:
+            data += [TYPO_CHARS[c]] + encode_link(child)
+        if not children:
             return data + [0]
+        return data + [TYPO_CHARS[children[0][0]] | 64]  # Inline edge ends the node, its target follows.
 
     byte_offset = 0
-    for e in table:  # To encode links, first compute byte offset of each entry.
-        e['byte_offset'] = byte_offset
-        byte_offset += len(serialize(e))
+    for node in table:  # To encode links, first compute byte offset of each node.
+        node['byte_offset'] = byte_offset
+        byte_offset += len(serialize(node))
         assert 0 <= byte_offset <= 0xffff
 
-    return [b for e in table for b in serialize(e)]  # Serialize final table.
+    return [b for node in table for b in serialize(node)]  # Serialize final table.
 
 
 def encode_link(link: Dict[str, Any]) -> List[int]:
@@ -257,8 +262,8 @@ def to_hex(b: int) -> str:
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
-    trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    automaton = make_automaton(autocorrections)
+    data = serialize_automaton(automaton)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -281,6 +286,7 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
+    autocorrect_data_h_lines.append('#define AUTOCORRECT_AUTOMATON')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include "util.h"
 #include "debug.h"
+#include "eeprom_driver.h"
 #include "eeprom_legacy_emulated_flash.h"
 #include "legacy_flash_ops.h"
 
@@ -80,6 +81,25 @@
  * Otherwise a Write log entry is constructed and appended to the next free position in the Write log.
  *
  *
+ * *** Checkpointed Compaction ***
+ *
+ * Defining FEE_CHECKPOINTED_COMPACTION splits the pages into two banks, each laid out as above
+ * with a checkpoint between the Compacted-flash area and the Write log:
+ *
+ * ╔═════════════ Checkpoint ═════════════╗
+ * ║Sequence║~Sequence║ Seal Low║Seal High║
+ * ╚════════╩═════════╩═════════╩═════════╝
+ *
+ * Once the active bank's Write log passes FEE_CHECKPOINT_THRESHOLD, the other bank is erased a page
+ * at a time and the cache is copied into its Compacted-flash area FEE_CHECKPOINT_STEP_SIZE bytes at a
+ * time, from eeprom_task() while the keyboard is idle. Writes made to the part already copied are
+ * replayed into the new Write log, then the checkpoint is written with the next sequence number and
+ * the new bank becomes active. During initialization only the sealed bank with the newest sequence
+ * is loaded, so only the Write log written since that checkpoint is replayed. A power loss before
+ * the seal is written leaves the previous bank in use. If the Write log fills before the checkpoint
+ * completes, the remaining steps are run before the triggering write returns.
+ *
+ *
  * *** Write Log Structure ***
  *
  * Write log entries allow for optimized byte writes to addresses below 128. Writing 0 or 1 words are also optimized when word-aligned.
@@ -155,6 +175,28 @@ static uint8_t *DataBuf = (uint8_t *)WordBuf;
 /* Pointer to the first available slot within the write log */
 static uint16_t *empty_slot;
 
+#ifdef FEE_CHECKPOINTED_COMPACTION
+/* Written last, marks a bank as holding a complete checkpoint */
+#    define FEE_CHECKPOINT_SEAL 0x5EA1C0DE
+
+#    define FEE_BANK_PAGE_COUNT (FEE_PAGE_COUNT / 2)
+
+enum { CHECKPOINT_IDLE, CHECKPOINT_ERASE, CHECKPOINT_COPY, CHECKPOINT_SEAL };
+
+static struct {
+    uintptr_t bank_offset; // offset of the active bank from FEE_PAGE_BASE_ADDRESS
+    uint16_t  sequence;    // sequence number of the active bank
+    uint8_t   state;
+    uint16_t  erase_page;  // next page of the other bank to erase
+    uint16_t  copy_offset; // next byte of the cache to copy
+    uint16_t  dirty_start; // written since being copied, replayed when sealing
+    uint16_t  dirty_end;
+} checkpoint;
+
+#    define FEE_ACTIVE_BANK_OFFSET checkpoint.bank_offset
+#    define FEE_SPARE_BANK_OFFSET (checkpoint.bank_offset ? 0 : FEE_BANK_SIZE)
+#endif
+
 // #define DEBUG_EEPROM_OUTPUT
 
 /*
@@ -213,7 +255,38 @@ void print_eeprom(void) {
 #endif
 }
 
+#ifdef FEE_CHECKPOINTED_COMPACTION
+/* Check whether the bank at the supplied offset holds a complete checkpoint */
+static bool eeprom_bank_sealed(uintptr_t bank_offset, uint16_t *sequence) {
+    uint16_t *words = (uint16_t *)(FEE_PAGE_BASE_ADDRESS + bank_offset + FEE_DENSITY_BYTES);
+    *sequence       = words[0];
+    return words[0] == (uint16_t)~words[1] && words[2] == (uint16_t)FEE_CHECKPOINT_SEAL && words[3] == (uint16_t)(FEE_CHECKPOINT_SEAL >> 16);
+}
+
+/* Select the sealed bank with the newest sequence, or the first bank if neither is sealed */
+static void eeprom_select_bank(void) {
+    uint16_t   sequence0, sequence1;
+    const bool sealed0 = eeprom_bank_sealed(0, &sequence0);
+    const bool sealed1 = eeprom_bank_sealed(FEE_BANK_SIZE, &sequence1);
+
+    /* Sequence numbers wrap, so compare using the signed difference */
+    if (sealed1 && (!sealed0 || (int16_t)(uint16_t)(sequence1 - sequence0) > 0)) {
+        checkpoint.bank_offset = FEE_BANK_SIZE;
+        checkpoint.sequence    = sequence1;
+    } else {
+        checkpoint.bank_offset = 0;
+        checkpoint.sequence    = sealed0 ? sequence0 : 0;
+    }
+    checkpoint.state = CHECKPOINT_IDLE;
+    eeprom_printf("eeprom_select_bank: bank %d, sequence %u\n", checkpoint.bank_offset ? 1 : 0, checkpoint.sequence);
+}
+#endif
+
 uint16_t EEPROM_Init(void) {
+#ifdef FEE_CHECKPOINTED_COMPACTION
+    eeprom_select_bank();
+#endif
+
     /* Load emulated eeprom contents from compacted flash into memory */
     uint16_t *src  = (uint16_t *)FEE_COMPACTED_BASE_ADDRESS;
     uint16_t *dest = (uint16_t *)DataBuf;
@@ -312,6 +385,9 @@ void EEPROM_Erase(void) {
     EEPROM_Init();
 }
 
+#ifdef FEE_CHECKPOINTED_COMPACTION
+static uint8_t eeprom_compact(void);
+#else
 /* Compact write log */
 static uint8_t eeprom_compact(void) {
     /* Erase compacted pages and write log */
@@ -343,6 +419,7 @@ static uint8_t eeprom_compact(void) {
 
     return final_status;
 }
+#endif
 
 static uint8_t eeprom_write_direct_entry(uint16_t Address) {
     /* Check if we can just write this directly to the compacted flash area */
@@ -436,6 +513,197 @@ static uint8_t eeprom_write_log_byte_entry(uint16_t Address) {
     return status;
 }
 
+#ifdef FEE_CHECKPOINTED_COMPACTION
+/* Record a write to a word the copy has already passed, so it is replayed when sealing */
+static void eeprom_checkpoint_touch(uint16_t Address) {
+    Address &= 0xFFFE;
+    if (checkpoint.state < CHECKPOINT_COPY || Address >= checkpoint.copy_offset) {
+        return;
+    }
+    if (Address < checkpoint.dirty_start) {
+        checkpoint.dirty_start = Address;
+    }
+    if (Address + 2 > checkpoint.dirty_end) {
+        checkpoint.dirty_end = Address + 2;
+    }
+}
+
+/* Bring a word of the newly copied bank up to date with the cache */
+static uint8_t eeprom_checkpoint_replay(uint16_t Address) {
+    /* Words left empty by the copy can still be written directly */
+    FLASH_Status status = eeprom_write_direct_entry(Address);
+    if (status) {
+        return status;
+    }
+
+    uint16_t copied = ~*(uint16_t *)(FEE_COMPACTED_BASE_ADDRESS + Address);
+    uint16_t value  = *(uint16_t *)(&DataBuf[Address]);
+    if (copied == value) {
+        return FLASH_COMPLETE;
+    }
+    if (Address >= FEE_BYTE_RANGE) {
+        return eeprom_write_log_word_entry(Address);
+    }
+
+    status = FLASH_COMPLETE;
+    if ((uint8_t)copied != (uint8_t)value) {
+        status = eeprom_write_log_byte_entry(Address);
+    }
+    if ((copied >> 8) != (value >> 8)) {
+        FLASH_Status high_status = eeprom_write_log_byte_entry(Address + 1);
+        if (high_status != FLASH_COMPLETE) status = high_status;
+    }
+    return status;
+}
+
+/* Final checkpoint step: switch to the other bank, replay writes made during the copy, then seal it */
+static uint8_t eeprom_checkpoint_seal(void) {
+    uint16_t dirty_length = checkpoint.dirty_end > checkpoint.dirty_start ? checkpoint.dirty_end - checkpoint.dirty_start : 0;
+
+    /* Each word needs at most four bytes of write log. Copy everything again rather than use more than half of it */
+    if (dirty_length * 2 > FEE_WRITE_LOG_BYTES / 2) {
+        eeprom_println("eeprom_checkpoint_seal: too many writes during copy, restarting");
+        checkpoint.state      = CHECKPOINT_ERASE;
+        checkpoint.erase_page = 0;
+        return FLASH_COMPLETE;
+    }
+
+    uintptr_t previous_offset = checkpoint.bank_offset;
+    uint16_t *previous_slot   = empty_slot;
+    checkpoint.bank_offset    = FEE_SPARE_BANK_OFFSET;
+    empty_slot                = (uint16_t *)FEE_WRITE_LOG_BASE_ADDRESS;
+
+    FLASH_Status final_status = FLASH_COMPLETE;
+    for (uint16_t address = checkpoint.dirty_start; address < checkpoint.dirty_end; address += 2) {
+        FLASH_Status status = eeprom_checkpoint_replay(address);
+        if (status != FLASH_COMPLETE) final_status = status;
+    }
+
+    uint16_t sequence = checkpoint.sequence + 1;
+    if (final_status == FLASH_COMPLETE) {
+        uint16_t words[] = {sequence, (uint16_t)~sequence, (uint16_t)FEE_CHECKPOINT_SEAL, (uint16_t)(FEE_CHECKPOINT_SEAL >> 16)};
+
+        FLASH_Unlock();
+        /* The seal is written last, so an interrupted checkpoint is never selected */
+        for (uint8_t i = 0; i < ARRAY_SIZE(words) && final_status == FLASH_COMPLETE; ++i) {
+            eeprom_printf("FLASH_ProgramHalfWord(0x%08lx, 0x%04x) [CHECKPOINT]\n", (uint32_t)(FEE_CHECKPOINT_ADDRESS + i * 2), words[i]);
+            final_status = FLASH_ProgramHalfWord(FEE_CHECKPOINT_ADDRESS + i * 2, words[i]);
+        }
+        FLASH_Lock();
+    }
+
+    checkpoint.state = CHECKPOINT_IDLE;
+    if (final_status != FLASH_COMPLETE) {
+        /* The previous bank and its write log are untouched, carry on using them */
+        eeprom_printf("eeprom_checkpoint_seal [STATUS == %d]\n", final_status);
+        checkpoint.bank_offset = previous_offset;
+        empty_slot             = previous_slot;
+        return final_status;
+    }
+
+    /* Switched over -- the previous bank is erased when the next checkpoint starts */
+    checkpoint.sequence = sequence;
+    if (debug_eeprom) {
+        println("eeprom_checkpoint_seal:");
+        print_eeprom();
+    }
+    return FLASH_COMPLETE;
+}
+
+/* Perform a single bounded step of a checkpoint */
+static uint8_t eeprom_checkpoint_step(void) {
+    switch (checkpoint.state) {
+        case CHECKPOINT_ERASE: {
+            uintptr_t page = FEE_PAGE_BASE_ADDRESS + FEE_SPARE_BANK_OFFSET + checkpoint.erase_page * FEE_PAGE_SIZE;
+
+            /* Skip pages that are already blank */
+            FLASH_Status status = FLASH_COMPLETE;
+            for (uint16_t *word = (uint16_t *)page; word < (uint16_t *)(page + FEE_PAGE_SIZE); ++word) {
+                if (*word != FEE_EMPTY_WORD) {
+                    FLASH_Unlock();
+                    eeprom_printf("FLASH_ErasePage(0x%04lx)\n", (uint32_t)page);
+                    status = FLASH_ErasePage(page);
+                    FLASH_Lock();
+                    break;
+                }
+            }
+            if (status != FLASH_COMPLETE) {
+                checkpoint.state = CHECKPOINT_IDLE;
+                return status;
+            }
+
+            if (++checkpoint.erase_page >= FEE_BANK_PAGE_COUNT) {
+                checkpoint.copy_offset = 0;
+                checkpoint.dirty_start = FEE_DENSITY_BYTES;
+                checkpoint.dirty_end   = 0;
+                checkpoint.state       = CHECKPOINT_COPY;
+            }
+            return FLASH_COMPLETE;
+        }
+
+        case CHECKPOINT_COPY: {
+            uint16_t *src  = (uint16_t *)(&DataBuf[checkpoint.copy_offset]);
+            uintptr_t dest = FEE_PAGE_BASE_ADDRESS + FEE_SPARE_BANK_OFFSET + checkpoint.copy_offset;
+            uint16_t  end  = MIN(checkpoint.copy_offset + FEE_CHECKPOINT_STEP_SIZE, FEE_DENSITY_BYTES);
+
+            FLASH_Status status = FLASH_COMPLETE;
+            FLASH_Unlock();
+            for (; checkpoint.copy_offset < end; checkpoint.copy_offset += 2, ++src, dest += 2) {
+                if (*src) {
+                    status = FLASH_ProgramHalfWord(dest, ~*src);
+                    if (status != FLASH_COMPLETE) break;
+                }
+            }
+            FLASH_Lock();
+            if (status != FLASH_COMPLETE) {
+                eeprom_printf("eeprom_checkpoint_step copy [STATUS == %d]\n", status);
+                checkpoint.state = CHECKPOINT_IDLE;
+                return status;
+            }
+
+            if (checkpoint.copy_offset >= FEE_DENSITY_BYTES) {
+                checkpoint.state = CHECKPOINT_SEAL;
+            }
+            return FLASH_COMPLETE;
+        }
+
+        case CHECKPOINT_SEAL:
+            return eeprom_checkpoint_seal();
+
+        default:
+            return FLASH_COMPLETE;
+    }
+}
+
+/* Run the remaining steps of a checkpoint in-line, starting one if none is in progress */
+static uint8_t eeprom_compact(void) {
+    if (checkpoint.state == CHECKPOINT_IDLE) {
+        checkpoint.state      = CHECKPOINT_ERASE;
+        checkpoint.erase_page = 0;
+    }
+
+    FLASH_Status status = FLASH_COMPLETE;
+    while (checkpoint.state != CHECKPOINT_IDLE && status == FLASH_COMPLETE) {
+        status = eeprom_checkpoint_step();
+    }
+    return status;
+}
+
+bool EEPROM_CheckpointStep(void) {
+    if (checkpoint.state == CHECKPOINT_IDLE) {
+        if ((uintptr_t)empty_slot - FEE_WRITE_LOG_BASE_ADDRESS < FEE_CHECKPOINT_THRESHOLD) {
+            return false;
+        }
+        eeprom_println("EEPROM_CheckpointStep: starting checkpoint");
+        checkpoint.state      = CHECKPOINT_ERASE;
+        checkpoint.erase_page = 0;
+    }
+
+    eeprom_checkpoint_step();
+    return checkpoint.state != CHECKPOINT_IDLE;
+}
+#endif
+
 uint8_t EEPROM_WriteDataByte(uint16_t Address, uint8_t DataByte) {
     /* if the address is out-of-bounds, do nothing */
     if (Address >= FEE_DENSITY_BYTES) {
@@ -452,6 +720,9 @@ uint8_t EEPROM_WriteDataByte(uint16_t Address, uint8_t DataByte) {
     /* keep DataBuf cache in sync */
     DataBuf[Address] = DataByte;
     eeprom_printf("EEPROM_WriteDataByte DataBuf[0x%04x] = 0x%02x\n", Address, DataBuf[Address]);
+#ifdef FEE_CHECKPOINTED_COMPACTION
+    eeprom_checkpoint_touch(Address);
+#endif
 
     /* perform the write into flash memory */
     /* First, attempt to write directly into the compacted flash area */
@@ -499,6 +770,9 @@ uint8_t EEPROM_WriteDataWord(uint16_t Address, uint16_t DataWord) {
     /* keep DataBuf cache in sync */
     *(uint16_t *)(&DataBuf[Address]) = DataWord;
     eeprom_printf("EEPROM_WriteDataWord DataBuf[0x%04x] = 0x%04x\n", Address, *(uint16_t *)(&DataBuf[Address]));
+#ifdef FEE_CHECKPOINTED_COMPACTION
+    eeprom_checkpoint_touch(Address);
+#endif
 
     /* perform the write into flash memory */
     /* First, attempt to write directly into the compacted flash area */
@@ -564,13 +838,29 @@ void eeprom_driver_init(void) {
     EEPROM_Init();
 }
 
+#if defined(FEE_CHECKPOINTED_COMPACTION) && !defined(LEGACY_FLASH_OPS_MOCKED)
+#    include "keyboard.h"
+
+void eeprom_task(void) {
+    // Erasing a page stalls flash access, so wait for a pause in typing
+    if (last_input_activity_elapsed() >= FEE_CHECKPOINT_IDLE_MS) {
+        uint32_t begin = eeprom_stats_begin();
+        EEPROM_CheckpointStep();
+        eeprom_stats_blocked(begin);
+    }
+}
+#endif
+
 void eeprom_driver_erase(void) {
+    uint32_t begin = eeprom_stats_begin();
     EEPROM_Erase();
+    eeprom_stats_blocked(begin);
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
     const uint8_t *src  = (const uint8_t *)addr;
     uint8_t *      dest = (uint8_t *)buf;
+    eeprom_stats_read(addr, len);
 
     /* Check word alignment */
     if (len && (uintptr_t)src % 2) {
@@ -599,8 +889,10 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
-    uint8_t *      dest = (uint8_t *)addr;
-    const uint8_t *src  = (const uint8_t *)buf;
+    uint8_t *      dest  = (uint8_t *)addr;
+    const uint8_t *src   = (const uint8_t *)buf;
+    uint32_t       begin = eeprom_stats_begin();
+    eeprom_stats_write(addr, len);
 
     /* Check word alignment */
     if (len && (uintptr_t)dest % 2) {
@@ -626,4 +918,5 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
     if (len) {
         EEPROM_WriteDataByte((uintptr_t)dest, *src);
     }
+    eeprom_stats_blocked(begin);
 }
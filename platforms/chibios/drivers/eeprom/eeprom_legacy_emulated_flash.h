@@ -23,11 +23,17 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 uint16_t EEPROM_Init(void);
 void     EEPROM_Erase(void);
 uint8_t  EEPROM_WriteDataByte(uint16_t Address, uint8_t DataByte);
 uint8_t  EEPROM_WriteDataWord(uint16_t Address, uint16_t DataWord);
 uint8_t  EEPROM_ReadDataByte(uint16_t Address);
 uint16_t EEPROM_ReadDataWord(uint16_t Address);
+#ifdef FEE_CHECKPOINTED_COMPACTION
+/* Runs one step of a checkpoint, starting one once the write log passes FEE_CHECKPOINT_THRESHOLD. Returns true while steps remain. */
+bool EEPROM_CheckpointStep(void);
+#endif
 
 void print_eeprom(void);
@@ -86,14 +86,29 @@
 #    endif
 #endif
 
+/* Size of each bank of compacted eeprom and write log */
+#ifdef FEE_CHECKPOINTED_COMPACTION
+#    if (FEE_PAGE_COUNT % 2) == 1
+#        error emulated eeprom: FEE_CHECKPOINTED_COMPACTION requires an even FEE_PAGE_COUNT
+#    endif
+#    define FEE_BANK_SIZE (FEE_DENSITY_MAX_SIZE / 2)
+/* Sequence number, its complement and a two word seal, following the compacted area */
+#    define FEE_CHECKPOINT_BYTES 8
+#else
+#    define FEE_BANK_SIZE FEE_DENSITY_MAX_SIZE
+#    define FEE_CHECKPOINT_BYTES 0
+/* Single bank, which is always active */
+#    define FEE_ACTIVE_BANK_OFFSET 0
+#endif
+
 /* Size of emulated eeprom */
 #ifdef FEE_DENSITY_BYTES
-#    if (FEE_DENSITY_BYTES > FEE_DENSITY_MAX_SIZE)
-#        pragma message STR(FEE_DENSITY_BYTES) " > " STR(FEE_DENSITY_MAX_SIZE)
+#    if (FEE_DENSITY_BYTES > FEE_BANK_SIZE - FEE_CHECKPOINT_BYTES)
+#        pragma message STR(FEE_DENSITY_BYTES) " > " STR(FEE_BANK_SIZE - FEE_CHECKPOINT_BYTES)
 #        error emulated eeprom: FEE_DENSITY_BYTES exceeds FEE_DENSITY_MAX_SIZE
 #    endif
-#    if (FEE_DENSITY_BYTES == FEE_DENSITY_MAX_SIZE)
-#        pragma message STR(FEE_DENSITY_BYTES) " == " STR(FEE_DENSITY_MAX_SIZE)
+#    if (FEE_DENSITY_BYTES == FEE_BANK_SIZE - FEE_CHECKPOINT_BYTES)
+#        pragma message STR(FEE_DENSITY_BYTES) " == " STR(FEE_BANK_SIZE - FEE_CHECKPOINT_BYTES)
 #        warning emulated eeprom: FEE_DENSITY_BYTES leaves no room for a write log.  This will greatly increase the flash wear rate!
 #    endif
 #    if FEE_DENSITY_BYTES > FEE_ADDRESS_MAX_SIZE
@@ -105,13 +120,13 @@
 #    endif
 #else
 /* Default to half of allocated space used for emulated eeprom, half for write log */
-#    define FEE_DENSITY_BYTES (FEE_PAGE_COUNT * FEE_PAGE_SIZE / 2)
+#    define FEE_DENSITY_BYTES (FEE_BANK_SIZE / 2)
 #endif
 
 /* Size of write log */
 #ifdef FEE_WRITE_LOG_BYTES
-#    if ((FEE_DENSITY_BYTES + FEE_WRITE_LOG_BYTES) > FEE_DENSITY_MAX_SIZE)
-#        pragma message STR(FEE_DENSITY_BYTES) " + " STR(FEE_WRITE_LOG_BYTES) " > " STR(FEE_DENSITY_MAX_SIZE)
+#    if ((FEE_DENSITY_BYTES + FEE_CHECKPOINT_BYTES + FEE_WRITE_LOG_BYTES) > FEE_BANK_SIZE)
+#        pragma message STR(FEE_DENSITY_BYTES) " + " STR(FEE_WRITE_LOG_BYTES) " > " STR(FEE_BANK_SIZE - FEE_CHECKPOINT_BYTES)
 #        error emulated eeprom: FEE_WRITE_LOG_BYTES exceeds remaining FEE_DENSITY_MAX_SIZE
 #    endif
 #    if ((FEE_WRITE_LOG_BYTES) % 2) == 1
@@ -119,15 +134,35 @@
 #    endif
 #else
 /* Default to use all remaining space */
-#    define FEE_WRITE_LOG_BYTES (FEE_PAGE_COUNT * FEE_PAGE_SIZE - FEE_DENSITY_BYTES)
+#    define FEE_WRITE_LOG_BYTES (FEE_BANK_SIZE - FEE_CHECKPOINT_BYTES - FEE_DENSITY_BYTES)
+#endif
+
+#ifdef FEE_CHECKPOINTED_COMPACTION
+/* Write log usage that starts a checkpoint of the other bank */
+#    ifndef FEE_CHECKPOINT_THRESHOLD
+#        define FEE_CHECKPOINT_THRESHOLD (FEE_WRITE_LOG_BYTES / 2)
+#    endif
+/* Bytes of emulated eeprom copied to the other bank per step, must be even */
+#    ifndef FEE_CHECKPOINT_STEP_SIZE
+#        define FEE_CHECKPOINT_STEP_SIZE 64
+#    endif
+#    if ((FEE_CHECKPOINT_STEP_SIZE) % 2) == 1
+#        error emulated eeprom: FEE_CHECKPOINT_STEP_SIZE must be even
+#    endif
+/* Milliseconds without keyboard input before checkpoint steps are run */
+#    ifndef FEE_CHECKPOINT_IDLE_MS
+#        define FEE_CHECKPOINT_IDLE_MS 250
+#    endif
 #endif
 
 /* Start of the emulated eeprom compacted flash area */
-#define FEE_COMPACTED_BASE_ADDRESS FEE_PAGE_BASE_ADDRESS
+#define FEE_COMPACTED_BASE_ADDRESS (FEE_PAGE_BASE_ADDRESS + FEE_ACTIVE_BANK_OFFSET)
 /* End of the emulated eeprom compacted flash area */
 #define FEE_COMPACTED_LAST_ADDRESS (FEE_COMPACTED_BASE_ADDRESS + FEE_DENSITY_BYTES)
+/* Start of the checkpoint words, only present with FEE_CHECKPOINTED_COMPACTION */
+#define FEE_CHECKPOINT_ADDRESS FEE_COMPACTED_LAST_ADDRESS
 /* Start of the emulated eeprom write log */
-#define FEE_WRITE_LOG_BASE_ADDRESS FEE_COMPACTED_LAST_ADDRESS
+#define FEE_WRITE_LOG_BASE_ADDRESS (FEE_CHECKPOINT_ADDRESS + FEE_CHECKPOINT_BYTES)
 /* End of the emulated eeprom write log */
 #define FEE_WRITE_LOG_LAST_ADDRESS (FEE_WRITE_LOG_BASE_ADDRESS + FEE_WRITE_LOG_BYTES)
 
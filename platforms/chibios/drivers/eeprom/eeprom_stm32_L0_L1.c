@@ -68,6 +68,7 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_stats_read(addr, len);
     for (size_t offset = 0; offset < len; ++offset) {
         // Drop out if we've hit the limit of the EEPROM
         if ((((uint32_t)addr) + offset) >= STM32_ONBOARD_EEPROM_SIZE) {
@@ -80,6 +81,7 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 }
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    eeprom_stats_write(addr, len);
     STM32_L0_L1_EEPROM_Unlock();
 
     for (size_t offset = 0; offset < len; ++offset) {
@@ -120,6 +120,49 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+bool backing_store_erase_bank(uint8_t bank) {
+    const flash_offset_t bank_start = base_offset + bank * (WEAR_LEVELING_BANK_SIZE);
+    const flash_offset_t bank_end   = bank_start + (WEAR_LEVELING_BANK_SIZE);
+
+    // Sectors can vary in size, refuse if any sector straddles a bank boundary as erasing it would lose the other bank
+    for (int i = 0; i < sector_count; ++i) {
+        const flash_offset_t sector_start = flashGetSectorOffset(flash, first_sector + i);
+        const flash_offset_t sector_end   = sector_start + flashGetSectorSize(flash, first_sector + i);
+        if (sector_start < bank_end && sector_end > bank_start && (sector_start < bank_start || sector_end > bank_end)) {
+            bs_dprintf("Sector %d straddles bank %d\n", (int)(first_sector + i), (int)bank);
+            return false;
+        }
+    }
+
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    bool          ret = true;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        const flash_offset_t sector_start = flashGetSectorOffset(flash, first_sector + i);
+        if (sector_start < bank_start || sector_start >= bank_end) {
+            continue;
+        }
+
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    bs_dprintf("Backing store bank %d erase took %ldms to complete\n", (int)bank, ((long)(timer_read32() - start)));
+    return ret;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
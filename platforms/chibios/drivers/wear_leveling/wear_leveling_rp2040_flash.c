@@ -187,6 +187,23 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+bool backing_store_erase_bank(uint8_t bank) {
+#    ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#    endif
+
+    _Static_assert((WEAR_LEVELING_BANK_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Bank size must be a multiple of FLASH_SECTOR_SIZE");
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + bank * (WEAR_LEVELING_BANK_SIZE), (WEAR_LEVELING_BANK_SIZE));
+    restore_interrupts(interrupts);
+
+    bs_dprintf("Backing store bank %d erase took %ldms to complete\n", (int)bank, ((long)(timer_read32() - start)));
+    return true;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -22,6 +22,19 @@ void     eeprom_update_dword(uint32_t *__p, uint32_t __value);
 void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #endif
 
+#if defined(EEPROM_WRITE_BACK)
+#    if !defined(EEPROM_WEAR_LEVELING)
+#        error EEPROM_WRITE_BACK is only supported by the wear_leveling EEPROM driver.
+#    endif
+void eeprom_sync(void);
+#else
+static inline void eeprom_sync(void) {}
+#endif
+
+#if defined(EEPROM_WRITE_BACK) || defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION) || defined(FEE_CHECKPOINTED_COMPACTION)
+void eeprom_task(void);
+#endif
+
 #if defined(EEPROM_CUSTOM)
 #    ifndef EEPROM_SIZE
 #        error EEPROM_SIZE has not been defined for custom driver.
@@ -61,7 +74,11 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef LEGACY_FLASH_OPS_MOCKED
 // Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+#        ifdef EEPROM_SIZE
+#            define TOTAL_EEPROM_BYTE_COUNT (EEPROM_SIZE)
+#        else
+#            define TOTAL_EEPROM_BYTE_COUNT 32
+#        endif
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_legacy_emulated_flash_tests.h"
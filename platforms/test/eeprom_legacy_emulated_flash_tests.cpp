@@ -42,11 +42,35 @@ extern "C" {
  * [Unused | Compact |  Write Log  ]
  * [0......|512......|768......1023]
  *
+ * === Checkpoint Layout ===
+ * flash size: 2048
+ * page size: 256
+ * density pages: 8, in two banks
+ * Simulated EEPROM size: 512
+ *
+ * FlashBuf Layout:
+ * [ Compact | Checkpoint | Write Log ][ Compact | Checkpoint | Write Log ]
+ * [0........|512.........|520........][1024.....|1536........|1544.......2047]
+ *
  */
 
-#define LOG_SIZE EEPROM_SIZE
-#define LOG_BASE (MOCK_FLASH_SIZE - LOG_SIZE)
-#define EEPROM_BASE (LOG_BASE - EEPROM_SIZE)
+#ifdef FEE_CHECKPOINTED_COMPACTION
+#    define BANK_COUNT 2
+#    define CHECKPOINT_SIZE 8
+#else
+#    define BANK_COUNT 1
+#    define CHECKPOINT_SIZE 0
+#endif
+#define BANK_SIZE (FEE_PAGE_SIZE * FEE_PAGE_COUNT / BANK_COUNT)
+#define BANK_BASE(bank) (MOCK_FLASH_SIZE - (BANK_COUNT - (bank)) * BANK_SIZE)
+#define BANK_CHECKPOINT_BASE(bank) (BANK_BASE(bank) + EEPROM_SIZE)
+#define BANK_LOG_BASE(bank) (BANK_CHECKPOINT_BASE(bank) + CHECKPOINT_SIZE)
+/* Bank in use after the first compaction */
+#define COMPACTED_BANK (BANK_COUNT - 1)
+
+#define LOG_SIZE (BANK_SIZE - EEPROM_SIZE - CHECKPOINT_SIZE)
+#define LOG_BASE BANK_LOG_BASE(0)
+#define EEPROM_BASE BANK_BASE(0)
 
 /* Log encoding helpers */
 #define BYTE_VALUE(addr, value) (((addr) << 8) | (value))
@@ -432,6 +456,169 @@ TEST_F(EepromStm32Test, TestCompaction) {
     EXPECT_EQ(eeprom_read_word((uint16_t*)6), 0xd00d);
     EXPECT_EQ(eeprom_read_dword((uint32_t*)150), 0xcafef00d);
     EXPECT_EQ(eeprom_read_dword((uint32_t*)200), val);
-    EXPECT_EQ(*(uint16_t*)&FlashBuf[LOG_BASE], 0xFFFF);
-    EXPECT_EQ(*(uint16_t*)&FlashBuf[LOG_BASE + LOG_SIZE - 2], 0xFFFF);
+    EXPECT_EQ(*(uint16_t*)&FlashBuf[BANK_LOG_BASE(COMPACTED_BANK)], 0xFFFF);
+    EXPECT_EQ(*(uint16_t*)&FlashBuf[BANK_LOG_BASE(COMPACTED_BANK) + LOG_SIZE - 2], 0xFFFF);
+}
+
+#ifdef FEE_CHECKPOINTED_COMPACTION
+/* Checkpoint encoding helpers */
+#    define CHECKPOINT_SEAL_LOW 0xC0DE
+#    define CHECKPOINT_SEAL_HIGH 0x5EA1
+
+class EepromStm32CheckpointTest : public EepromStm32Test {
+   protected:
+    /* Each write after the first appends eight bytes to the write log */
+    uint32_t fill_log(int count) {
+        uint32_t val = 0x1b2c3d4e;
+        for (int i = 0; i < count; i++) {
+            val = val * 0x9e3779b1 + i;
+            eeprom_write_dword((uint32_t*)200, val);
+        }
+        return val;
+    }
+
+    int run_checkpoint(void) {
+        int steps = 1;
+        while (EEPROM_CheckpointStep()) {
+            ++steps;
+        }
+        return steps;
+    }
+
+    uint16_t flash_word(uint32_t offset) {
+        return *(uint16_t*)&FlashBuf[offset];
+    }
+
+    void seal(int bank, uint16_t sequence) {
+        uint16_t* words = (uint16_t*)&FlashBuf[BANK_CHECKPOINT_BASE(bank)];
+        words[0]        = sequence;
+        words[1]        = ~sequence;
+        words[2]        = CHECKPOINT_SEAL_LOW;
+        words[3]        = CHECKPOINT_SEAL_HIGH;
+    }
+};
+
+TEST_F(EepromStm32CheckpointTest, TestStartsAtThreshold) {
+    fill_log(30);
+    EXPECT_FALSE(EEPROM_CheckpointStep());
+    fill_log(5);
+    EXPECT_TRUE(EEPROM_CheckpointStep());
+}
+
+TEST_F(EepromStm32CheckpointTest, TestCheckpointInSteps) {
+    eeprom_write_dword((uint32_t*)0, 0xdeadbeef);
+    eeprom_write_word((uint16_t*)150, 0xcafe);
+    uint32_t val = fill_log(50);
+
+    /* Four page erases, eight copies and the seal */
+    EXPECT_EQ(run_checkpoint(), 13);
+    EXPECT_EQ(flash_word(BANK_CHECKPOINT_BASE(1)), 1);
+    EXPECT_EQ(flash_word(BANK_CHECKPOINT_BASE(1) + 6), CHECKPOINT_SEAL_HIGH);
+    EXPECT_EQ(flash_word(BANK_LOG_BASE(1)), 0xFFFF);
+    EXPECT_EQ(*(uint32_t*)&FlashBuf[BANK_BASE(1) + 200], ~val);
+
+    /* Later writes go to the new bank's write log */
+    eeprom_write_word((uint16_t*)150, 0xf00d);
+    EXPECT_EQ(flash_word(BANK_LOG_BASE(1)), WORD_NEXT(150));
+
+    EEPROM_Init();
+    EXPECT_EQ(eeprom_read_dword((uint32_t*)0), 0xdeadbeef);
+    EXPECT_EQ(eeprom_read_word((uint16_t*)150), 0xf00d);
+    EXPECT_EQ(eeprom_read_dword((uint32_t*)200), val);
+}
+
+TEST_F(EepromStm32CheckpointTest, TestWritesDuringCopyAreReplayed) {
+    eeprom_write_byte((uint8_t*)4, 0x3c);
+    eeprom_write_word((uint16_t*)100, 0x1234);
+    fill_log(50);
+
+    /* Erase the spare bank and copy the first half */
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(EEPROM_CheckpointStep());
+    }
+    /* Already copied */
+    eeprom_write_byte((uint8_t*)4, 0x1f);
+    eeprom_write_byte((uint8_t*)10, 0x42);
+    eeprom_write_word((uint16_t*)100, 0x5678);
+    /* Not yet copied */
+    eeprom_write_dword((uint32_t*)300, 0xba5eba11);
+    run_checkpoint();
+
+    EXPECT_EQ(flash_word(BANK_CHECKPOINT_BASE(1) + 6), CHECKPOINT_SEAL_HIGH);
+    EXPECT_EQ(flash_word(BANK_LOG_BASE(1)), BYTE_VALUE(4, 0x1f));
+    EEPROM_Init();
+    EXPECT_EQ(eeprom_read_byte((uint8_t*)4), 0x1f);
+    EXPECT_EQ(eeprom_read_byte((uint8_t*)10), 0x42);
+    EXPECT_EQ(eeprom_read_word((uint16_t*)100), 0x5678);
+    EXPECT_EQ(eeprom_read_dword((uint32_t*)300), 0xba5eba11);
+}
+
+TEST_F(EepromStm32CheckpointTest, TestManyWritesDuringCopyRestart) {
+    fill_log(50);
+    for (int i = 0; i < 8; i++) {
+        EEPROM_CheckpointStep();
+    }
+    /* Too many to replay into the new write log */
+    for (int i = 0; i < 256; i += 2) {
+        eeprom_write_word((uint16_t*)i, 0x100 + i);
+    }
+    EXPECT_GT(run_checkpoint(), 13);
+
+    EXPECT_EQ(flash_word(BANK_CHECKPOINT_BASE(1) + 6), CHECKPOINT_SEAL_HIGH);
+    EXPECT_EQ(flash_word(BANK_LOG_BASE(1)), 0xFFFF);
+    EEPROM_Init();
+    for (int i = 0; i < 256; i += 2) {
+        EXPECT_EQ(eeprom_read_word((uint16_t*)i), 0x100 + i);
+    }
+}
+
+TEST_F(EepromStm32CheckpointTest, TestInterruptedCheckpointKeepsPreviousBank) {
+    eeprom_write_dword((uint32_t*)0, 0xdeadbeef);
+    uint32_t val = fill_log(50);
+
+    /* Power lost before the seal is written */
+    for (int i = 0; i < 12; i++) {
+        EXPECT_TRUE(EEPROM_CheckpointStep());
+    }
+    EEPROM_Init();
+    EXPECT_EQ(eeprom_read_dword((uint32_t*)0), 0xdeadbeef);
+    EXPECT_EQ(eeprom_read_dword((uint32_t*)200), val);
+
+    /* Still appending to the first bank */
+    eeprom_write_dword((uint32_t*)0, 0xfacef00d);
+    EXPECT_EQ(flash_word(BANK_LOG_BASE(0) + 49 * 8), BYTE_VALUE(0, 0x0d));
+    EEPROM_Init();
+    EXPECT_EQ(eeprom_read_dword((uint32_t*)0), 0xfacef00d);
+}
+
+TEST_F(EepromStm32CheckpointTest, TestBanksAlternate) {
+    fill_log(50);
+    run_checkpoint();
+    uint32_t val = fill_log(50);
+    run_checkpoint();
+
+    EXPECT_EQ(flash_word(BANK_CHECKPOINT_BASE(0)), 2);
+    EXPECT_EQ(flash_word(BANK_CHECKPOINT_BASE(1)), 1);
+    EXPECT_EQ(*(uint32_t*)&FlashBuf[BANK_BASE(0) + 200], ~val);
+    eeprom_write_word((uint16_t*)200, 0xcafe);
+    EXPECT_EQ(flash_word(BANK_LOG_BASE(0)), WORD_NEXT(200));
+
+    EEPROM_Init();
+    EXPECT_EQ(eeprom_read_word((uint16_t*)200), 0xcafe);
+    EXPECT_EQ(eeprom_read_word((uint16_t*)202), val >> 16);
+}
+
+TEST_F(EepromStm32CheckpointTest, TestSequenceWraps) {
+    FlashBuf[BANK_BASE(0) + 2] = ~0x11;
+    FlashBuf[BANK_BASE(1) + 2] = ~0x22;
+    seal(0, 0xFFFF);
+    seal(1, 0x0000);
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_ReadDataByte(2), 0x22);
+
+    /* An unsealed bank is never selected */
+    FlashBuf[BANK_CHECKPOINT_BASE(1) + 6] = 0;
+    EEPROM_Init();
+    EXPECT_EQ(EEPROM_ReadDataByte(2), 0x11);
 }
+#endif
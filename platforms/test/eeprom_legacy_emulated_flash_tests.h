@@ -5,4 +5,8 @@
 #include "legacy_flash_ops.h"
 #include "eeprom_legacy_emulated_flash.h"
 
-#define EEPROM_SIZE (FEE_PAGE_SIZE * FEE_PAGE_COUNT / 2)
+#ifdef FEE_CHECKPOINTED_COMPACTION
+#    define EEPROM_SIZE (FEE_PAGE_SIZE * FEE_PAGE_COUNT / 4)
+#else
+#    define EEPROM_SIZE (FEE_PAGE_SIZE * FEE_PAGE_COUNT / 2)
+#endif
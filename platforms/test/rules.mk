@@ -9,12 +9,20 @@ eeprom_legacy_emulated_flash_large_DEFS := $(eeprom_legacy_emulated_flash_DEFS)
 	-DMOCK_FLASH_SIZE=65536 \
 	-DFEE_PAGE_SIZE=2048 \
 	-DFEE_PAGE_COUNT=16
+eeprom_legacy_emulated_flash_checkpoint_DEFS := $(eeprom_legacy_emulated_flash_DEFS) \
+	-DFEE_MCU_FLASH_SIZE=2 \
+	-DMOCK_FLASH_SIZE=2048 \
+	-DFEE_PAGE_SIZE=256 \
+	-DFEE_PAGE_COUNT=8 \
+	-DFEE_CHECKPOINTED_COMPACTION \
+	-DFEE_CHECKPOINT_STEP_SIZE=64
 
 eeprom_legacy_emulated_flash_INC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/ \
 	$(PLATFORM_PATH)/chibios/drivers/flash/
 eeprom_legacy_emulated_flash_tiny_INC := $(eeprom_legacy_emulated_flash_INC)
 eeprom_legacy_emulated_flash_large_INC := $(eeprom_legacy_emulated_flash_INC)
+eeprom_legacy_emulated_flash_checkpoint_INC := $(eeprom_legacy_emulated_flash_INC)
 
 eeprom_legacy_emulated_flash_SRC := \
 	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
@@ -23,3 +31,4 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+eeprom_legacy_emulated_flash_checkpoint_SRC := $(eeprom_legacy_emulated_flash_SRC)
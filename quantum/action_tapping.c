@@ -55,6 +55,12 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 }
 #    endif
 
+#    ifdef TAP_HOLD_PREDICTION_PER_KEY
+__attribute__((weak)) bool get_tap_hold_prediction(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+#    endif
+
 #    if defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)
 #        include "process_auto_shift.h"
 #    endif
@@ -73,12 +79,35 @@ static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+#    ifdef TAP_HOLD_PREDICTION
+typedef struct {
+    keypos_t key;
+    uint16_t tap_time; // rolling average of how long the key is down when tapped
+    uint8_t  samples;
+} tap_hold_key_stats_t;
+
+static tap_hold_key_stats_t tap_hold_key_stats[TAP_HOLD_PREDICTION_KEYS] = {};
+static uint16_t             tap_hold_press_gap                           = 0; // rolling average of the gap between presses
+static uint8_t              tap_hold_press_samples                       = 0;
+static uint16_t             tap_hold_last_press                          = 0;
+static uint16_t             tap_hold_last_gap                            = UINT16_MAX;
+static bool                 tap_hold_typing                              = false;
+
+static void tap_hold_prediction_processed(keyevent_t event);
+static void tap_hold_prediction_tapped(keyevent_t event);
+static bool tap_hold_prediction_is_roll(keyevent_t event);
+#        define TAP_HOLD_PREDICTION_PROCESSED(e) tap_hold_prediction_processed(e)
+#    else
+#        define TAP_HOLD_PREDICTION_PROCESSED(e)
+#    endif
+
 /** \brief Action Tapping Process
  *
  * FIXME: Needs doc
  */
 void action_tapping_process(keyrecord_t record) {
     if (process_tapping(&record)) {
+        TAP_HOLD_PREDICTION_PROCESSED(record.event);
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
             debug_record(record);
@@ -100,6 +129,7 @@ void action_tapping_process(keyrecord_t record) {
     }
     for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            TAP_HOLD_PREDICTION_PROCESSED(waiting_buffer[waiting_buffer_tail].event);
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
@@ -157,6 +187,19 @@ void action_tapping_process(keyrecord_t record) {
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS false
 #    endif
 
+#    ifdef TAP_HOLD_PREDICTION_PER_KEY
+#        define TAP_GET_TAP_HOLD_PREDICTION get_tap_hold_prediction(tapping_keycode, &tapping_key)
+#    else
+#        define TAP_GET_TAP_HOLD_PREDICTION true
+#    endif
+
+// Only a predicted tap reaches tap count 1 while its key is still pressed
+#    ifdef TAP_HOLD_PREDICTION
+#        define TAP_HOLD_PREDICTED_TAP (tapping_key.tap.count == 1 && tapping_key.event.pressed)
+#    else
+#        define TAP_HOLD_PREDICTED_TAP false
+#    endif
+
 /** \brief Tapping
  *
  * Rule: Tap key is typed(pressed and released) within TAPPING_TERM.
@@ -188,7 +231,7 @@ bool process_tapping(keyrecord_t *keyp) {
         return true;
     }
 
-#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
+#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY) || defined(TAP_HOLD_PREDICTION_PER_KEY)
     TAP_DEFINE_KEYCODE;
 #    endif
 
@@ -270,6 +313,21 @@ bool process_tapping(keyrecord_t *keyp) {
                 } else {
                     // set interrupted flag when other key pressed during tapping
                     if (event.pressed) {
+#    ifdef TAP_HOLD_PREDICTION
+                        /* Resolve a roll as a tap straight away, rather than holding the
+                         * other keys back until the tapping key is released.
+                         */
+                        if (TAP_GET_TAP_HOLD_PREDICTION && !TAP_GET_RETRO_TAPPING(keyp) && tap_hold_prediction_is_roll(event)) {
+                            ac_dprintf("Tapping: First tap(0->1). Predicted roll\n");
+                            tapping_key.tap.count = 1;
+                            debug_tapping_key();
+                            process_record(&tapping_key);
+                            // the other key still keeps this from starting sequential taps
+                            tapping_key.tap.interrupted = true;
+                            // enqueue
+                            return false;
+                        }
+#    endif
                         tapping_key.tap.interrupted = true;
                         if (TAP_GET_HOLD_ON_OTHER_KEY_PRESS
 #    if defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)
@@ -294,13 +352,16 @@ bool process_tapping(keyrecord_t *keyp) {
             else {
                 if (IS_TAPPING_RECORD(keyp) && !event.pressed) {
                     ac_dprintf("Tapping: Tap release(%u)\n", tapping_key.tap.count);
+#    ifdef TAP_HOLD_PREDICTION
+                    tap_hold_prediction_tapped(event);
+#    endif
                     keyp->tap = tapping_key.tap;
                     process_record(keyp);
                     tapping_key = *keyp;
                     debug_tapping_key();
                     return true;
                 } else if (is_tap_record(keyp) && event.pressed) {
-                    if (tapping_key.tap.count > 1) {
+                    if (tapping_key.tap.count > 1 || TAP_HOLD_PREDICTED_TAP) {
                         ac_dprintf("Tapping: Start new tap with releasing last tap(>1).\n");
                         // unregister key
                         process_record(&(keyrecord_t){
@@ -351,7 +412,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     tapping_key = (keyrecord_t){0};
                     return true;
                 } else if (is_tap_record(keyp) && event.pressed) {
-                    if (tapping_key.tap.count > 1) {
+                    if (tapping_key.tap.count > 1 || TAP_HOLD_PREDICTED_TAP) {
                         ac_dprintf("Tapping: Start new tap with releasing last timeout tap(>1).\n");
                         // unregister key
                         process_record(&(keyrecord_t){
@@ -520,6 +581,95 @@ void waiting_buffer_scan_tap(void) {
     }
 }
 
+#    ifdef TAP_HOLD_PREDICTION
+/** \brief Rolling average of a typing statistic
+ *
+ * A plain mean for the first few samples, then an exponential moving average.
+ */
+static uint16_t tap_hold_average(uint16_t average, uint8_t samples, uint16_t sample) {
+    int32_t weight = samples < 8 ? samples + 1 : 8;
+    return average + ((int32_t)sample - average) / weight;
+}
+
+/** \brief Typing statistics of a dual-role key
+ *
+ * Returns NULL if the key has none, unless allocate is set, in which case the
+ * entry with the fewest samples is recycled.
+ */
+static tap_hold_key_stats_t *tap_hold_prediction_stats(keypos_t key, bool allocate) {
+    tap_hold_key_stats_t *fewest = &tap_hold_key_stats[0];
+    for (uint8_t i = 0; i < TAP_HOLD_PREDICTION_KEYS; i++) {
+        tap_hold_key_stats_t *stats = &tap_hold_key_stats[i];
+        if (stats->samples > 0 && KEYEQ(stats->key, key)) {
+            return stats;
+        }
+        if (stats->samples < fewest->samples) {
+            fewest = stats;
+        }
+    }
+    if (!allocate) {
+        return NULL;
+    }
+    *fewest = (tap_hold_key_stats_t){.key = key};
+    return fewest;
+}
+
+/** \brief Record the gap before a key press once it has been processed
+ *
+ * Presses are processed in order, so while a tapping key is undecided the last
+ * processed press is the tapping key itself.
+ */
+static void tap_hold_prediction_processed(keyevent_t event) {
+    if (!IS_EVENT(event) || !event.pressed) {
+        return;
+    }
+    tap_hold_last_gap   = tap_hold_typing ? TIMER_DIFF_16(event.time, tap_hold_last_press) : UINT16_MAX;
+    tap_hold_last_press = event.time;
+    tap_hold_typing     = true;
+    if (tap_hold_last_gap < TAP_HOLD_PREDICTION_IDLE_TERM) {
+        tap_hold_press_gap = tap_hold_average(tap_hold_press_gap, tap_hold_press_samples, tap_hold_last_gap);
+        if (tap_hold_press_samples < UINT8_MAX) tap_hold_press_samples++;
+    }
+}
+
+/** \brief Record how long the tapping key was down for a tap
+ */
+static void tap_hold_prediction_tapped(keyevent_t event) {
+    tap_hold_key_stats_t *stats = tap_hold_prediction_stats(tapping_key.event.key, true);
+    stats->tap_time             = tap_hold_average(stats->tap_time, stats->samples, TIMER_DIFF_16(event.time, tapping_key.event.time));
+    if (stats->samples < UINT8_MAX) stats->samples++;
+}
+
+/** \brief Decide whether another key press makes the tapping key a tap
+ *
+ * True when the tapping key was pressed mid-streak, and the other key went
+ * down before a typical tap of the tapping key would have been released.
+ */
+static bool tap_hold_prediction_is_roll(keyevent_t event) {
+    const tap_hold_key_stats_t *stats = tap_hold_prediction_stats(tapping_key.event.key, false);
+    if (!stats || stats->samples < TAP_HOLD_PREDICTION_MIN_SAMPLES || tap_hold_press_samples < TAP_HOLD_PREDICTION_MIN_SAMPLES) {
+        return false;
+    }
+    if (tap_hold_last_press != tapping_key.event.time || (uint32_t)tap_hold_last_gap * 100 > (uint32_t)tap_hold_press_gap * TAP_HOLD_PREDICTION_STREAK_PERCENT) {
+        return false;
+    }
+    return (uint32_t)TIMER_DIFF_16(event.time, tapping_key.event.time) * 100 < (uint32_t)stats->tap_time * TAP_HOLD_PREDICTION_TAP_PERCENT;
+}
+
+/** \brief Forget all typing statistics
+ */
+void tap_hold_prediction_clear(void) {
+    for (uint8_t i = 0; i < TAP_HOLD_PREDICTION_KEYS; i++) {
+        tap_hold_key_stats[i] = (tap_hold_key_stats_t){0};
+    }
+    tap_hold_press_gap     = 0;
+    tap_hold_press_samples = 0;
+    tap_hold_last_press    = 0;
+    tap_hold_last_gap      = UINT16_MAX;
+    tap_hold_typing        = false;
+}
+#    endif
+
 /** \brief Tapping key debug print
  *
  * FIXME: Needs docs
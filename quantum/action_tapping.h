@@ -34,17 +34,45 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define WAITING_BUFFER_SIZE 8
 
+#ifdef TAP_HOLD_PREDICTION
+/* number of dual-role keys to keep typing statistics for */
+#    ifndef TAP_HOLD_PREDICTION_KEYS
+#        define TAP_HOLD_PREDICTION_KEYS 8
+#    endif
+/* samples needed before statistics are trusted */
+#    ifndef TAP_HOLD_PREDICTION_MIN_SAMPLES
+#        define TAP_HOLD_PREDICTION_MIN_SAMPLES 4
+#    endif
+/* gap between presses(ms) treated as a pause in typing */
+#    ifndef TAP_HOLD_PREDICTION_IDLE_TERM
+#        define TAP_HOLD_PREDICTION_IDLE_TERM 500
+#    endif
+/* how far the gap before a dual-role key press may exceed the average gap(percent) and still be part of a streak */
+#    ifndef TAP_HOLD_PREDICTION_STREAK_PERCENT
+#        define TAP_HOLD_PREDICTION_STREAK_PERCENT 150
+#    endif
+/* how long a dual-role key may be down when another key is pressed, relative to its average tap(percent) */
+#    ifndef TAP_HOLD_PREDICTION_TAP_PERCENT
+#        define TAP_HOLD_PREDICTION_TAP_PERCENT 100
+#    endif
+#endif
+
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
 #endif
 
+#if defined(TAP_HOLD_PREDICTION) && !defined(NO_ACTION_TAPPING)
+void tap_hold_prediction_clear(void);
+#endif
+
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
 uint16_t get_quick_tap_term(uint16_t keycode, keyrecord_t *record);
 bool     get_permissive_hold(uint16_t keycode, keyrecord_t *record);
 bool     get_retro_tapping(uint16_t keycode, keyrecord_t *record);
 bool     get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record);
+bool     get_tap_hold_prediction(uint16_t keycode, keyrecord_t *record);
 
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
 extern uint16_t g_tapping_term;
@@ -287,19 +287,156 @@ static uint8_t get_mods_for_report(void) {
     return mods;
 }
 
+#ifndef PROTOCOL_VUSB
+static report_keyboard_t last_6kro_report;
+
+static void commit_6kro_report(report_keyboard_t *report) {
+    /* Only send the report if there are changes to propagate to the host. */
+    if (memcmp(report, &last_6kro_report, sizeof(report_keyboard_t)) != 0) {
+        memcpy(&last_6kro_report, report, sizeof(report_keyboard_t));
+        host_keyboard_send(report);
+    }
+}
+#endif
+
+#ifdef NKRO_ENABLE
+static report_nkro_t last_nkro_report;
+
+static void commit_nkro_report(report_nkro_t *report) {
+    /* Only send the report if there are changes to propagate to the host. */
+    if (memcmp(report, &last_nkro_report, sizeof(report_nkro_t)) != 0) {
+        memcpy(&last_nkro_report, report, sizeof(report_nkro_t));
+        host_nkro_send(report);
+    }
+}
+#endif
+
+#ifdef KEYBOARD_REPORT_BATCHING
+#    ifdef PROTOCOL_VUSB
+#        error "KEYBOARD_REPORT_BATCHING is not supported with V-USB"
+#    endif
+
+static bool report_batching = false;
+
+/* A change can join the staged report unless it undoes part of it, which the
+ * host would then never see, or it mixes modifier and key changes, which the
+ * host has to see in the order they happened.
+ */
+static bool batch_can_merge(bool staged_mods, bool staged_keys, bool next_mods, bool next_keys, bool undone) {
+    if (!staged_mods && !staged_keys) {
+        return true;
+    }
+    return !undone && !((staged_mods || next_mods) && (staged_keys || next_keys));
+}
+
+static bool batch_bits_undone(uint8_t sent, uint8_t staged, uint8_t next) {
+    return (staged & ~sent & ~next) || (~staged & sent & next);
+}
+
+static report_keyboard_t batch_6kro_report;
+static bool              batch_6kro_pending = false;
+
+static bool report_6kro_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool batch_6kro_keys_undone(const report_keyboard_t *sent, const report_keyboard_t *staged, const report_keyboard_t *next) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = staged->keys[i];
+        if (key && !report_6kro_has_key(sent, key) && !report_6kro_has_key(next, key)) {
+            return true;
+        }
+        key = sent->keys[i];
+        if (key && !report_6kro_has_key(staged, key) && report_6kro_has_key(next, key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void batch_6kro_stage(void) {
+    const report_keyboard_t *sent   = &last_6kro_report;
+    const report_keyboard_t *staged = batch_6kro_pending ? &batch_6kro_report : sent;
+    const report_keyboard_t *next   = keyboard_report;
+
+    bool staged_keys = memcmp(staged->keys, sent->keys, sizeof(sent->keys)) != 0;
+    bool next_keys   = memcmp(next->keys, staged->keys, sizeof(staged->keys)) != 0;
+    bool undone      = batch_bits_undone(sent->mods, staged->mods, next->mods) || batch_6kro_keys_undone(sent, staged, next);
+
+    if (batch_6kro_pending && !batch_can_merge(staged->mods != sent->mods, staged_keys, next->mods != staged->mods, next_keys, undone)) {
+        commit_6kro_report(&batch_6kro_report);
+    }
+    memcpy(&batch_6kro_report, keyboard_report, sizeof(report_keyboard_t));
+    batch_6kro_pending = true;
+}
+
+#    ifdef NKRO_ENABLE
+static report_nkro_t batch_nkro_report;
+static bool          batch_nkro_pending = false;
+
+static void batch_nkro_stage(void) {
+    const report_nkro_t *sent   = &last_nkro_report;
+    const report_nkro_t *staged = batch_nkro_pending ? &batch_nkro_report : sent;
+    const report_nkro_t *next   = nkro_report;
+
+    bool undone = batch_bits_undone(sent->mods, staged->mods, next->mods);
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS && !undone; i++) {
+        undone = batch_bits_undone(sent->bits[i], staged->bits[i], next->bits[i]);
+    }
+    bool staged_keys = memcmp(staged->bits, sent->bits, sizeof(sent->bits)) != 0;
+    bool next_keys   = memcmp(next->bits, staged->bits, sizeof(staged->bits)) != 0;
+
+    if (batch_nkro_pending && !batch_can_merge(staged->mods != sent->mods, staged_keys, next->mods != staged->mods, next_keys, undone)) {
+        commit_nkro_report(&batch_nkro_report);
+    }
+    memcpy(&batch_nkro_report, nkro_report, sizeof(report_nkro_t));
+    batch_nkro_pending = true;
+}
+#    endif
+
+void keyboard_report_batch_begin(void) {
+    report_batching = true;
+}
+
+void keyboard_report_batch_flush(void) {
+    if (batch_6kro_pending) {
+        batch_6kro_pending = false;
+        commit_6kro_report(&batch_6kro_report);
+    }
+#    ifdef NKRO_ENABLE
+    if (batch_nkro_pending) {
+        batch_nkro_pending = false;
+        commit_nkro_report(&batch_nkro_report);
+    }
+#    endif
+}
+
+void keyboard_report_batch_end(void) {
+    report_batching = false;
+    keyboard_report_batch_flush();
+}
+#endif
+
 void send_6kro_report(void) {
     keyboard_report->mods = get_mods_for_report();
 
 #ifdef PROTOCOL_VUSB
     host_keyboard_send(keyboard_report);
 #else
-    static report_keyboard_t last_report;
-
-    /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
-        memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
-        host_keyboard_send(keyboard_report);
+#    ifdef KEYBOARD_REPORT_BATCHING
+    if (report_batching) {
+        batch_6kro_stage();
+    } else {
+        commit_6kro_report(keyboard_report);
     }
+#    else
+    commit_6kro_report(keyboard_report);
+#    endif
 #    ifdef APDAPTIVE_NKRO_ENABLE
     kb_report_changed &= ~KB_RPT_STD;
 #    endif
@@ -311,13 +448,16 @@ void send_nkro_report(void) {
 #    ifndef APDAPTIVE_NKRO_ENABLE
     nkro_report->mods = get_mods_for_report();
 #    endif
-    static report_nkro_t last_report;
 
-    /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(nkro_report, &last_report, sizeof(report_nkro_t)) != 0) {
-        memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
-        host_nkro_send(nkro_report);
+#    ifdef KEYBOARD_REPORT_BATCHING
+    if (report_batching) {
+        batch_nkro_stage();
+    } else {
+        commit_nkro_report(nkro_report);
     }
+#    else
+    commit_nkro_report(nkro_report);
+#    endif
 #    ifdef APDAPTIVE_NKRO_ENABLE
     kb_report_changed &= ~KB_RPT_NKRO;
 #    endif
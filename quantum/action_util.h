@@ -37,6 +37,16 @@ extern uint8_t nkro_bit_count;
 
 void send_keyboard_report(void);
 
+#ifdef KEYBOARD_REPORT_BATCHING
+/* Hold keyboard reports back and merge them until the batch ends */
+void keyboard_report_batch_begin(void);
+void keyboard_report_batch_end(void);
+/* Send the keyboard reports held back so far, keeping the batch open */
+void keyboard_report_batch_flush(void);
+#else
+static inline void keyboard_report_batch_flush(void) {}
+#endif
+
 /* key */
 inline void add_key(uint8_t key) {
     add_key_to_report(key);
@@ -0,0 +1,56 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "boot_profile.h"
+#include "timer.h"
+
+#define BOOT_PROFILE_MAGIC 0xB0071A6E
+
+#if defined(PROTOCOL_CHIBIOS)
+// Not touched by the startup code, so the previous profile survives a reset
+#    define BOOT_PROFILE_RETAINED __attribute__((section(".ram0.boot_profile")))
+#else
+#    define BOOT_PROFILE_RETAINED
+#endif
+
+typedef struct {
+    uint32_t       magic;
+    boot_profile_t profiles[2]; // current, then previous
+} boot_profile_store_t;
+
+static boot_profile_store_t boot_profile_store BOOT_PROFILE_RETAINED;
+
+void boot_profile_start(boot_reason_t reason) {
+    if (boot_profile_store.magic == BOOT_PROFILE_MAGIC) {
+        boot_profile_store.profiles[1] = boot_profile_store.profiles[0];
+    } else {
+        // Power on, RAM holds nothing worth keeping
+        boot_profile_store.magic                = BOOT_PROFILE_MAGIC;
+        boot_profile_store.profiles[1].recorded = 0;
+        boot_profile_store.profiles[1].reason   = 0xFF;
+    }
+
+    boot_profile_t *profile = &boot_profile_store.profiles[0];
+    profile->start          = timer_read32();
+    profile->recorded       = 0;
+    profile->reason         = reason;
+}
+
+void boot_profile_mark(boot_phase_t phase) {
+    boot_profile_t *profile = &boot_profile_store.profiles[0];
+    if (boot_profile_store.magic != BOOT_PROFILE_MAGIC || (profile->recorded & (1 << phase))) {
+        return;
+    }
+    uint32_t elapsed        = timer_elapsed32(profile->start);
+    profile->elapsed[phase] = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+    profile->recorded |= 1 << phase;
+}
+
+const boot_profile_t *boot_profile_get(bool previous) {
+    const boot_profile_t *profile = &boot_profile_store.profiles[previous ? 1 : 0];
+    if (boot_profile_store.magic != BOOT_PROFILE_MAGIC || profile->reason > BOOT_REASON_WAKE) {
+        return NULL;
+    }
+    return profile;
+}
@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \defgroup boot_profile Boot Profile API
+ *
+ * \brief Records how long each phase of startup, or of waking from a low power mode, takes to reach.
+ *
+ * \{
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** \brief Points in startup that are timed, relative to boot_profile_start()
+ */
+typedef enum {
+    BOOT_PHASE_EEPROM_READY,
+    BOOT_PHASE_KEYBOARD_INIT,
+    BOOT_PHASE_MATRIX_READY,
+    BOOT_PHASE_QUANTUM_READY,
+    BOOT_PHASE_POST_INIT,
+    BOOT_PHASE_FIRST_SCAN,
+    BOOT_PHASE_FIRST_REPORT,
+    BOOT_PHASE_DEFERRED_INIT,
+    // Free for keyboard level code
+    BOOT_PHASE_KB_0,
+    BOOT_PHASE_KB_1,
+    BOOT_PHASE_KB_2,
+    BOOT_PHASE_COUNT,
+} boot_phase_t;
+
+/** \brief What the profile started from
+ */
+typedef enum {
+    BOOT_REASON_RESET,
+    BOOT_REASON_WAKE,
+} boot_reason_t;
+
+typedef struct {
+    uint32_t start;                     // timer_read32() at boot_profile_start()
+    uint16_t recorded;                  // bitmask of the phases reached
+    uint16_t elapsed[BOOT_PHASE_COUNT]; // milliseconds from start to each phase
+    uint8_t  reason;
+} boot_profile_t;
+
+/** \brief Begin a new profile, keeping the current one as the previous profile
+ */
+void boot_profile_start(boot_reason_t reason);
+
+/** \brief Record reaching a phase, later calls for the same phase are ignored until the next boot_profile_start()
+ */
+void boot_profile_mark(boot_phase_t phase);
+
+/** \brief Get the current profile, or the one before it
+ *
+ * \return NULL if there is no such profile
+ */
+const boot_profile_t *boot_profile_get(bool previous);
+
+/** \} */
@@ -12,24 +12,129 @@
 //------------------------------------
 // Helpers
 //
+// Each table is kept as a binary min-heap ordered by trigger time. The entries in use are always contiguous at the
+// start of the table, and table[0] is the next one due. Trigger times are compared relative to each other, which is
+// safe across timer wraparound as long as they are all within ~24 days of each other.
+//
 
 static deferred_token current_token = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+static inline bool triggers_before(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static inline void clear_entry(deferred_executor_t *entry) {
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+}
+
+static inline void swap_entries(deferred_executor_t *table, size_t a, size_t b) {
+    deferred_executor_t tmp = table[a];
+    table[a]                = table[b];
+    table[b]                = tmp;
+}
+
+// Number of entries in use
+static size_t heap_count(deferred_executor_t *table, size_t table_count) {
+    size_t low = 0, high = table_count;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (table[mid].token != INVALID_DEFERRED_TOKEN) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static size_t heap_sift_up(deferred_executor_t *table, size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!triggers_before(&table[index], &table[parent])) {
+            break;
+        }
+        swap_entries(table, index, parent);
+        index = parent;
     }
-    for (int i = 0; i < table_count; ++i) {
+    return index;
+}
+
+static void heap_sift_down(deferred_executor_t *table, size_t count, size_t index) {
+    while (true) {
+        size_t earliest = index;
+        size_t left     = 2 * index + 1;
+        size_t right    = left + 1;
+        if (left < count && triggers_before(&table[left], &table[earliest])) {
+            earliest = left;
+        }
+        if (right < count && triggers_before(&table[right], &table[earliest])) {
+            earliest = right;
+        }
+        if (earliest == index) {
+            break;
+        }
+        swap_entries(table, index, earliest);
+        index = earliest;
+    }
+}
+
+// Restore the heap after the trigger time of the entry at index changed
+static void heap_fix(deferred_executor_t *table, size_t count, size_t index) {
+    if (heap_sift_up(table, index) == index) {
+        heap_sift_down(table, count, index);
+    }
+}
+
+static void heap_remove(deferred_executor_t *table, size_t count, size_t index) {
+    size_t last = count - 1;
+    if (index != last) {
+        table[index] = table[last];
+    }
+    clear_entry(&table[last]);
+    if (index < last) {
+        heap_fix(table, last, index);
+    }
+}
+
+static inline bool is_due(const deferred_executor_t *entry, uint32_t now) {
+    return ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0;
+}
+
+// Earliest due entry in the subtree at index that has not run yet in this pass, or best if there is none earlier.
+// Entries after a not yet run one trigger no earlier, so only the ones that already ran are looked past, and a
+// subtree whose root is not due is skipped entirely.
+static size_t earliest_pending(deferred_executor_t *table, size_t count, size_t index, uint32_t now, const uint8_t *ran, size_t best) {
+    if (index >= count || !is_due(&table[index], now)) {
+        return best;
+    }
+    if (!(ran[table[index].token / 8] & (1 << (table[index].token % 8)))) {
+        return (best == count || triggers_before(&table[index], &table[best])) ? index : best;
+    }
+    best = earliest_pending(table, count, 2 * index + 1, now, ran, best);
+    return earliest_pending(table, count, 2 * index + 2, now, ran, best);
+}
+
+static inline bool find_token(deferred_executor_t *table, size_t count, deferred_token token, size_t *index) {
+    for (size_t i = 0; i < count; ++i) {
         if (table[i].token == token) {
-            return false;
+            *index = i;
+            return true;
         }
     }
-    return true;
+    return false;
+}
+
+static inline bool token_can_be_used(deferred_executor_t *table, size_t count, deferred_token token) {
+    size_t index;
+    return token != INVALID_DEFERRED_TOKEN && !find_token(table, count, token, &index);
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
+static inline deferred_token allocate_token(deferred_executor_t *table, size_t count) {
     deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
+    while (!token_can_be_used(table, count, current_token)) {
         ++current_token;
         if (current_token == first) {
             // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
@@ -49,27 +154,26 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    // Claim the slot after the entries in use, if there is one
+    size_t count = heap_count(table, table_count);
+    if (count == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry, then move it to its place in the heap
+    deferred_executor_t *entry = &table[count];
+    entry->token               = token;
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    heap_sift_up(table, count);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +183,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    size_t count = heap_count(table, table_count);
+    size_t index;
+    if (!find_token(table, count, token, &index)) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    table[index].trigger_time = timer_read32() + delay_ms;
+    heap_fix(table, count, index);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +202,23 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    size_t count = heap_count(table, table_count);
+    size_t index;
+    if (!find_token(table, count, token, &index)) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    heap_remove(table, count, index);
+    return true;
+}
+
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+    *trigger_time = table[0].trigger_time;
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,29 +228,46 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry = &table[i];
-
-            // Check if we're supposed to execute this entry
-            if (entry->token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+        // Nothing to do unless the earliest executor is due
+        if (!table || table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN || !is_due(&table[0], now)) {
+            return;
+        }
+
+        // Each executor runs at most once per pass, even if it is still due after being requeued, so one that is
+        // catching up cannot hold back the others.
+        uint8_t ran[(1 << (8 * sizeof(deferred_token))) / 8] = {0};
+
+        // Run the due executors earliest first, until the top of the heap is no longer due
+        while (true) {
+            size_t count = heap_count(table, table_count);
+            size_t index = earliest_pending(table, count, 0, now, ran, count);
+            if (index == count) {
+                break;
+            }
+            deferred_executor_t *entry = &table[index];
+            ran[entry->token / 8] |= 1 << (entry->token % 8);
+
+            // Invoke the callback and work out if we should be requeued
+            deferred_token token    = entry->token;
+            uint32_t       delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // The callback may have queued or cancelled executors, moving this one, or cancelled itself
+            count = heap_count(table, table_count);
+            if (!find_token(table, count, token, &index)) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                table[index].trigger_time += delay_ms;
+                heap_fix(table, count, index);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                heap_remove(table, count, index);
             }
         }
     }
@@ -166,6 +289,9 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+bool deferred_exec_next_deadline(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
@@ -15,74 +15,16 @@
  */
 
 #include "dynamic_keymap.h"
+#include "dynamic_keymap_eeprom.h"
 #include "keymap_introspection.h"
 #include "action.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
+#include "timer.h"
 #include "keycodes.h"
-
-#ifdef VIA_ENABLE
-#    include "via.h"
-#    define DYNAMIC_KEYMAP_EEPROM_START (VIA_EEPROM_CONFIG_END)
-#else
-#    include "eeconfig.h"
-#    define DYNAMIC_KEYMAP_EEPROM_START (EECONFIG_SIZE)
-#endif
-
-#ifdef ENCODER_ENABLE
-#    include "encoder.h"
-#else
-#    define NUM_ENCODERS 0
-#endif
-
-#ifndef DYNAMIC_KEYMAP_LAYER_COUNT
-#    define DYNAMIC_KEYMAP_LAYER_COUNT 4
-#endif
-
-#ifndef DYNAMIC_KEYMAP_MACRO_COUNT
-#    define DYNAMIC_KEYMAP_MACRO_COUNT 16
-#endif
-
-#ifndef TOTAL_EEPROM_BYTE_COUNT
-#    error Unknown total EEPROM size. Cannot derive maximum for dynamic keymaps.
-#endif
-
-#ifndef DYNAMIC_KEYMAP_EEPROM_MAX_ADDR
-#    define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
-#endif
-
-#if DYNAMIC_KEYMAP_EEPROM_MAX_ADDR > (TOTAL_EEPROM_BYTE_COUNT - 1)
-#    pragma message STR(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) " > " STR((TOTAL_EEPROM_BYTE_COUNT - 1))
-#    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR is configured to use more space than what is available for the selected EEPROM driver
-#endif
-
-// Due to usage of uint16_t check for max 65535
-#if DYNAMIC_KEYMAP_EEPROM_MAX_ADDR > 65535
-#    pragma message STR(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) " > 65535"
-#    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR must be less than 65536
-#endif
-
-// If DYNAMIC_KEYMAP_EEPROM_ADDR not explicitly defined in config.h,
-#ifndef DYNAMIC_KEYMAP_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
-#endif
-
-// Dynamic encoders starts after dynamic keymaps
-#ifndef DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
-#endif
-
-// Dynamic macro starts after dynamic encoders, but only when using ENCODER_MAP
-#ifdef ENCODER_MAP_ENABLE
-#    ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
-#        define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2))
-#    endif // DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
-#else      // ENCODER_MAP_ENABLE
-#    ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
-#        define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR)
-#    endif // DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
-#endif     // ENCODER_MAP_ENABLE
+#include "util.h"
+#include <string.h>
 
 // Sanity check that dynamic keymaps fit in available EEPROM
 // If there's not 100 bytes available for macros, then something is wrong.
@@ -91,16 +33,15 @@
 // more than the default.
 _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) >= 100, "Dynamic keymaps are configured to use more EEPROM than is available.");
 
-// Dynamic macros are stored after the keymaps and use what is available
-// up to and including DYNAMIC_KEYMAP_EEPROM_MAX_ADDR.
-#ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE
-#    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
-#endif
-
 #ifndef DYNAMIC_KEYMAP_MACRO_DELAY
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+// Macros triggered while another is still playing wait their turn, up to this many
+#ifndef DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE 4
+#endif
+
 #ifdef KEYCODE_BUFFER_ENABLE
 static uint8_t layer_buffer = 0xFF;
 static uint8_t row_buffer = 0xFF;
@@ -108,17 +49,136 @@ static uint8_t col_buffer = 0xFF;
 static uint16_t keycode_buffer = 0;
 #endif
 
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+// Decoded copy of the sparse layers, indexed from the first key of DYNAMIC_KEYMAP_DENSE_LAYER_COUNT
+static uint16_t sparse_keycodes[DYNAMIC_KEYMAP_SPARSE_KEYS];
+static uint8_t  sparse_bitmap[(DYNAMIC_KEYMAP_SPARSE_KEYS + 7) / 8];
+static uint16_t sparse_used   = 0;
+static bool     sparse_loaded = false;
+
+static void dynamic_keymap_sparse_load(void) {
+    eeprom_read_block(sparse_bitmap, (void *)(uintptr_t)DYNAMIC_KEYMAP_SPARSE_BITMAP_EEPROM_ADDR, sizeof(sparse_bitmap));
+
+    sparse_used = 0;
+    for (uint16_t index = 0; index < DYNAMIC_KEYMAP_SPARSE_KEYS; index++) {
+        uint8_t mask = 1 << (index % 8);
+        if ((sparse_bitmap[index / 8] & mask) && sparse_used < DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+            void *address          = (void *)(uintptr_t)(DYNAMIC_KEYMAP_SPARSE_POOL_EEPROM_ADDR + sparse_used * 2);
+            sparse_keycodes[index] = (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+            sparse_used++;
+        } else {
+            // Keys beyond the end of the pool can only come from a corrupt bitmap, drop them
+            sparse_bitmap[index / 8] &= ~mask;
+            sparse_keycodes[index] = KC_TRNS;
+        }
+    }
+    sparse_loaded = true;
+}
+
+// Pool slot of a sparse key, the number of non-transparent keys before it
+static uint16_t dynamic_keymap_sparse_slot(uint16_t index) {
+    uint16_t slot = 0;
+    for (uint16_t i = 0; i < index / 8; i++) {
+        slot += __builtin_popcount(sparse_bitmap[i]);
+    }
+    return slot + __builtin_popcount(sparse_bitmap[index / 8] & ((1 << (index % 8)) - 1));
+}
+
+// Moves pool slots [from, sparse_used) to start at to, working in the direction that doesn't overwrite slots yet to be moved
+static void dynamic_keymap_sparse_move(uint16_t from, uint16_t to) {
+    uint8_t  chunk[32];
+    uint16_t length = (sparse_used - from) * 2;
+    while (length > 0) {
+        uint16_t size   = MIN(sizeof(chunk), length);
+        uint16_t offset = to > from ? length - size : (sparse_used - from) * 2 - length;
+        eeprom_read_block(chunk, (void *)(uintptr_t)(DYNAMIC_KEYMAP_SPARSE_POOL_EEPROM_ADDR + from * 2 + offset), size);
+        eeprom_update_block(chunk, (void *)(uintptr_t)(DYNAMIC_KEYMAP_SPARSE_POOL_EEPROM_ADDR + to * 2 + offset), size);
+        length -= size;
+    }
+}
+
+static void dynamic_keymap_sparse_set(uint16_t index, uint16_t keycode) {
+    if (keycode == sparse_keycodes[index]) {
+        return;
+    }
+
+    uint8_t  mask        = 1 << (index % 8);
+    bool     present     = keycode != KC_TRNS;
+    bool     was_present = sparse_bitmap[index / 8] & mask;
+    uint16_t slot        = dynamic_keymap_sparse_slot(index);
+
+    if (present && !was_present) {
+        if (sparse_used == DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+            // Out of room, the key stays transparent
+            return;
+        }
+        dynamic_keymap_sparse_move(slot, slot + 1);
+        sparse_used++;
+        sparse_bitmap[index / 8] |= mask;
+    } else if (!present && was_present) {
+        dynamic_keymap_sparse_move(slot + 1, slot);
+        sparse_used--;
+        sparse_bitmap[index / 8] &= ~mask;
+    }
+
+    if (present) {
+        void *address = (void *)(uintptr_t)(DYNAMIC_KEYMAP_SPARSE_POOL_EEPROM_ADDR + slot * 2);
+        eeprom_update_byte(address, (uint8_t)(keycode >> 8));
+        eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    }
+    eeprom_update_byte((void *)(uintptr_t)(DYNAMIC_KEYMAP_SPARSE_BITMAP_EEPROM_ADDR + index / 8), sparse_bitmap[index / 8]);
+    sparse_keycodes[index] = keycode;
+}
+
+static void dynamic_keymap_sparse_reset(void) {
+    memset(sparse_bitmap, 0, sizeof(sparse_bitmap));
+    eeprom_update_block(sparse_bitmap, (void *)(uintptr_t)DYNAMIC_KEYMAP_SPARSE_BITMAP_EEPROM_ADDR, sizeof(sparse_bitmap));
+    for (uint16_t index = 0; index < DYNAMIC_KEYMAP_SPARSE_KEYS; index++) {
+        sparse_keycodes[index] = KC_TRNS;
+    }
+    sparse_used   = 0;
+    sparse_loaded = true;
+
+    // Keys are added in pool order, so nothing needs to move
+    uint16_t index = 0;
+    for (int layer = DYNAMIC_KEYMAP_DENSE_LAYER_COUNT; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            for (int column = 0; column < MATRIX_COLS; column++) {
+                dynamic_keymap_sparse_set(index++, keycode_at_keymap_location_raw(layer, row, column));
+            }
+        }
+    }
+}
+
+// Index in the sparse layers of a keycode of the flat keymap buffer
+static uint16_t dynamic_keymap_sparse_index(uint16_t key) {
+    if (!sparse_loaded) {
+        dynamic_keymap_sparse_load();
+    }
+    return key - (DYNAMIC_KEYMAP_DENSE_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS);
+}
+#endif // DYNAMIC_KEYMAP_SPARSE_LAYERS
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
 void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+    // Sparse layers have no fixed location
+    if (layer >= DYNAMIC_KEYMAP_DENSE_LAYER_COUNT) return NULL;
+#endif
     // TODO: optimize this with some left shifts
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+    if (layer >= DYNAMIC_KEYMAP_DENSE_LAYER_COUNT) {
+        return sparse_keycodes[dynamic_keymap_sparse_index((layer * MATRIX_ROWS + row) * MATRIX_COLS + column)];
+    }
+#endif
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
 #ifdef KEYCODE_BUFFER_ENABLE
     uint16_t keycode = eeprom_read_word(address);
@@ -137,6 +197,12 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
 #ifdef KEYCODE_BUFFER_ENABLE
     if (layer == layer_buffer && row == row_buffer && column == col_buffer)
         layer_buffer = row_buffer = col_buffer = 0xFF;
+#endif
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+    if (layer >= DYNAMIC_KEYMAP_DENSE_LAYER_COUNT) {
+        dynamic_keymap_sparse_set(dynamic_keymap_sparse_index((layer * MATRIX_ROWS + row) * MATRIX_COLS + column), keycode);
+        return;
+    }
 #endif
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
 #ifdef KEYCODE_BUFFER_ENABLE
@@ -179,7 +245,7 @@ void dynamic_keymap_reset(void) {
     layer_buffer = row_buffer = col_buffer = 0xFF;
 #endif
     // Reset the keymaps in EEPROM to what is in flash.
-    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+    for (int layer = 0; layer < DYNAMIC_KEYMAP_DENSE_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
             for (int column = 0; column < MATRIX_COLS; column++) {
 #ifdef KEYCODE_BUFFER_ENABLE
@@ -192,42 +258,69 @@ void dynamic_keymap_reset(void) {
         }
 #ifdef KEYCODE_BUFFER_ENABLE
         eeprom_update_block(keymap_buffer, dynamic_keymap_key_to_eeprom_address(layer, 0, 0),sizeof(keymap_buffer));
+#endif
+    }
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+    dynamic_keymap_sparse_reset();
 #endif
 #ifdef ENCODER_MAP_ENABLE
+    for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int encoder = 0; encoder < NUM_ENCODERS; encoder++) {
             dynamic_keymap_set_encoder(layer, encoder, true, keycode_at_encodermap_location_raw(layer, encoder, true));
             dynamic_keymap_set_encoder(layer, encoder, false, keycode_at_encodermap_location_raw(layer, encoder, false));
         }
+    }
 #endif // ENCODER_MAP_ENABLE
+}
+
+// Number of bytes of a buffer request that fall within an EEPROM region of the given size
+static uint16_t dynamic_keymap_clamp_size(uint16_t offset, uint16_t size, uint16_t region_size) {
+    if (offset >= region_size) {
+        return 0;
     }
+    return MIN(size, region_size - offset);
 }
 
+// The buffer is always presented as flat big-endian layers, sparse layers are converted one keycode at a time
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    uint16_t valid_size                 = dynamic_keymap_clamp_size(offset, size, dynamic_keymap_eeprom_size);
+    uint16_t dense_size                 = dynamic_keymap_clamp_size(offset, valid_size, DYNAMIC_KEYMAP_DENSE_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2);
+    if (dense_size > 0) {
+        eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), dense_size);
     }
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+    for (uint16_t i = dense_size; i < valid_size; i++) {
+        uint16_t position = offset + i;
+        uint16_t keycode  = sparse_keycodes[dynamic_keymap_sparse_index(position / 2)];
+        data[i]           = (position & 1) ? (uint8_t)(keycode & 0xFF) : (uint8_t)(keycode >> 8);
+    }
+#endif
+    memset(data + valid_size, 0x00, size - valid_size);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+    uint16_t valid_size                 = dynamic_keymap_clamp_size(offset, size, dynamic_keymap_eeprom_size);
+    uint16_t dense_size                 = dynamic_keymap_clamp_size(offset, valid_size, DYNAMIC_KEYMAP_DENSE_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2);
+    if (dense_size > 0) {
+        eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), dense_size);
+    }
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+    for (uint16_t i = dense_size; i < valid_size;) {
+        uint16_t position = offset + i;
+        uint16_t index    = dynamic_keymap_sparse_index(position / 2);
+        uint16_t keycode  = sparse_keycodes[index];
+        // Either half of a keycode may fall outside the request
+        if (!(position & 1)) {
+            keycode = (keycode & 0x00FF) | (data[i++] << 8);
+        }
+        if (i < valid_size) {
+            keycode = (keycode & 0xFF00) | data[i++];
         }
-        source++;
-        target++;
+        dynamic_keymap_sparse_set(index, keycode);
     }
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -266,29 +359,72 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
+    uint16_t valid_size = dynamic_keymap_clamp_size(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    if (valid_size > 0) {
+        eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid_size);
+    }
+    memset(data + valid_size, 0x00, size - valid_size);
+}
+
+// Start of each macro relative to DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR, or DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE if it is not in the buffer
+static uint16_t macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     macro_offsets_valid = false;
+
+static struct {
+    bool              active;
+    uint16_t          offset;      // Next byte to decode, relative to DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
+    uint32_t          resume_time; // Nothing is sent before this time
+    send_char_steps_t steps;
+    uint8_t           queue[DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE];
+    uint8_t           queue_head;
+    uint8_t           queue_count;
+} macro_player;
+
+static void dynamic_keymap_macro_invalidate(void) {
+    macro_offsets_valid = false;
+    // The buffer is changing under the player, finish the keys already in flight and stop
+    macro_player.offset      = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+    macro_player.queue_count = 0;
+}
+
+static void dynamic_keymap_macro_build_index(void) {
+    uint8_t  chunk[32];
+    uint8_t  id    = 0;
+    uint16_t start = 0;
+
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && id < DYNAMIC_KEYMAP_MACRO_COUNT; offset += sizeof(chunk)) {
+        uint16_t size = MIN(sizeof(chunk), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset);
+        eeprom_read_block(chunk, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), size);
+        for (uint16_t i = 0; i < size && id < DYNAMIC_KEYMAP_MACRO_COUNT; i++) {
+            if (chunk[i] == 0) {
+                macro_offsets[id++] = start;
+                start               = offset + i + 1;
+            }
         }
-        source++;
-        target++;
     }
+    while (id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        macro_offsets[id++] = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+    }
+
+    // Check the last byte of the buffer.
+    // If it's not zero, then we are in the middle
+    // of buffer writing, possibly an aborted buffer
+    // write. So disable all macros.
+    if (eeprom_read_byte((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1)) != 0) {
+        for (id = 0; id < DYNAMIC_KEYMAP_MACRO_COUNT; id++) {
+            macro_offsets[id] = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+        }
+    }
+
+    macro_offsets_valid = true;
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t valid_size = dynamic_keymap_clamp_size(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    if (valid_size > 0) {
+        eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid_size);
     }
+    dynamic_keymap_macro_invalidate();
 }
 
 void dynamic_keymap_macro_reset(void) {
@@ -298,89 +434,134 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+    dynamic_keymap_macro_invalidate();
 }
 
 void dynamic_keymap_macro_send(uint8_t id) {
-    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT || macro_player.queue_count == DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE) {
         return;
     }
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
-        return;
-    }
+    // Playback happens in dynamic_keymap_macro_task()
+    macro_player.queue[(macro_player.queue_head + macro_player.queue_count) % DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE] = id;
+    macro_player.queue_count++;
+}
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then there is
-        // no Nth macro in the buffer.
-        if (p == end) {
-            return;
-        }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
-        }
-        ++p;
+bool dynamic_keymap_macro_is_playing(void) {
+    return macro_player.active || macro_player.queue_count > 0;
+}
+
+static uint8_t dynamic_keymap_macro_next_byte(void) {
+    if (macro_player.offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        return 0;
     }
+    return eeprom_read_byte((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + macro_player.offset++));
+}
 
-    // Send the macro string by making a temporary string.
-    char data[8] = {0};
-    // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
-        // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
-            break;
-        }
-        if (data[0] == SS_QMK_PREFIX) {
-            // Get the code
-            data[1] = eeprom_read_byte(p++);
+// Decodes the next action of the macro into steps, returns false at the end of the macro or if it is malformed
+static bool dynamic_keymap_macro_decode(void) {
+    uint16_t delay = DYNAMIC_KEYMAP_MACRO_DELAY;
+    uint8_t  code  = dynamic_keymap_macro_next_byte();
+
+    macro_player.steps.count        = 0;
+    macro_player.steps.next         = 0;
+    macro_player.steps.release_mask = 0;
+
+    // Stop at the null terminator of this macro string
+    if (code == 0) {
+        return false;
+    }
+    if (code == SS_QMK_PREFIX) {
+        // Get the code
+        code = dynamic_keymap_macro_next_byte();
+        if (code == SS_TAP_CODE || code == SS_DOWN_CODE || code == SS_UP_CODE) {
+            // Get the keycode
+            uint8_t keycode = dynamic_keymap_macro_next_byte();
             // Unexpected null, abort.
-            if (data[1] == 0) {
-                return;
+            if (keycode == 0) {
+                return false;
             }
-            if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
-                // Get the keycode
-                data[2] = eeprom_read_byte(p++);
-                // Unexpected null, abort.
-                if (data[2] == 0) {
-                    return;
+            macro_player.steps.keycodes[0] = keycode;
+            macro_player.steps.keycodes[1] = keycode;
+            if (code == SS_TAP_CODE) {
+                macro_player.steps.count        = 2;
+                macro_player.steps.release_mask = 1 << 1;
+            } else {
+                macro_player.steps.count        = 1;
+                macro_player.steps.release_mask = code == SS_UP_CODE ? 1 : 0;
+            }
+        } else if (code == SS_DELAY_CODE) {
+            // Get the number and '|'
+            // At most this is 4 digits plus '|'
+            uint16_t ms = 0;
+            for (uint8_t i = 0;; i++) {
+                code = dynamic_keymap_macro_next_byte();
+                if (code == '|') {
+                    break;
                 }
-                // Null terminate
-                data[3] = 0;
-            } else if (data[1] == SS_DELAY_CODE) {
-                // Get the number and '|'
-                // At most this is 4 digits plus '|'
-                uint8_t i = 2;
-                while (1) {
-                    data[i] = eeprom_read_byte(p++);
-                    // Unexpected null, abort
-                    if (data[i] == 0) {
-                        return;
-                    }
-                    // Found '|', send it
-                    if (data[i] == '|') {
-                        data[i + 1] = 0;
-                        break;
-                    }
-                    // If haven't found '|' by i==6 then
-                    // number too big, abort
-                    if (i == 6) {
-                        return;
-                    }
-                    ++i;
+                // Unexpected character or null, or number too big, abort
+                if (i == 4 || code < '0' || code > '9') {
+                    return false;
                 }
+                ms = ms * 10 + (code - '0');
             }
+            delay += ms;
+        } else if (code == 0) {
+            // Unexpected null, abort.
+            return false;
+        }
+    } else {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        if (code == '\a') {
+            send_char(code);
+        } else
+#endif
+        {
+            send_char_steps(code, &macro_player.steps);
+        }
+    }
+
+    // Keys are sent first, then the delay applies
+    macro_player.resume_time = timer_read32() + (macro_player.steps.count > 0 ? 0 : delay);
+    return true;
+}
+
+void dynamic_keymap_macro_task(void) {
+    if (!macro_player.active) {
+        if (macro_player.queue_count == 0) {
+            return;
+        }
+        uint8_t id              = macro_player.queue[macro_player.queue_head];
+        macro_player.queue_head = (macro_player.queue_head + 1) % DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE;
+        macro_player.queue_count--;
+
+        if (!macro_offsets_valid) {
+            dynamic_keymap_macro_build_index();
+        }
+        macro_player.offset      = macro_offsets[id];
+        macro_player.steps.count = 0;
+        macro_player.resume_time = timer_read32();
+        macro_player.active      = macro_player.offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+        return;
+    }
+
+    if (!timer_expired32(timer_read32(), macro_player.resume_time)) {
+        return;
+    }
+
+    if (macro_player.steps.next >= macro_player.steps.count) {
+        macro_player.active = dynamic_keymap_macro_decode();
+        return;
+    }
+
+    // One report per call, and only once the previous one has left the transport
+    uint8_t step = macro_player.steps.next;
+    if (send_char_steps_next(&macro_player.steps)) {
+        if (macro_player.steps.next == macro_player.steps.count) {
+            macro_player.resume_time = timer_read32() + DYNAMIC_KEYMAP_MACRO_DELAY;
+        } else if (!(macro_player.steps.release_mask & (1 << step))) {
+            // Hold a pressed key as long as tap_code() would
+            macro_player.resume_time = timer_read32() + (macro_player.steps.keycodes[step] == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
         }
-        send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
 }
@@ -67,4 +67,8 @@ void     dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void     dynamic_keymap_macro_reset(void);
 
+// Macros are played back from dynamic_keymap_macro_task(), one report at a time.
+// dynamic_keymap_macro_send() queues the macro and returns immediately.
 void dynamic_keymap_macro_send(uint8_t id);
+bool dynamic_keymap_macro_is_playing(void);
+void dynamic_keymap_macro_task(void);
@@ -0,0 +1,110 @@
+/* Copyright 2017 Jason Williams (Wilba)
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// EEPROM layout of the dynamic keymap, encoder map and macros, for code that needs to know where they live
+
+#include "eeprom.h"
+#include "util.h"
+
+#ifdef VIA_ENABLE
+#    include "via.h"
+#    define DYNAMIC_KEYMAP_EEPROM_START (VIA_EEPROM_CONFIG_END)
+#else
+#    include "eeconfig.h"
+#    define DYNAMIC_KEYMAP_EEPROM_START (EECONFIG_SIZE)
+#endif
+
+#ifdef ENCODER_ENABLE
+#    include "encoder.h"
+#else
+#    define NUM_ENCODERS 0
+#endif
+
+#ifndef DYNAMIC_KEYMAP_LAYER_COUNT
+#    define DYNAMIC_KEYMAP_LAYER_COUNT 4
+#endif
+
+#ifndef DYNAMIC_KEYMAP_MACRO_COUNT
+#    define DYNAMIC_KEYMAP_MACRO_COUNT 16
+#endif
+
+#ifndef TOTAL_EEPROM_BYTE_COUNT
+#    error Unknown total EEPROM size. Cannot derive maximum for dynamic keymaps.
+#endif
+
+#ifndef DYNAMIC_KEYMAP_EEPROM_MAX_ADDR
+#    define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
+#endif
+
+#if DYNAMIC_KEYMAP_EEPROM_MAX_ADDR > (TOTAL_EEPROM_BYTE_COUNT - 1)
+#    pragma message STR(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) " > " STR((TOTAL_EEPROM_BYTE_COUNT - 1))
+#    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR is configured to use more space than what is available for the selected EEPROM driver
+#endif
+
+// Due to usage of uint16_t check for max 65535
+#if DYNAMIC_KEYMAP_EEPROM_MAX_ADDR > 65535
+#    pragma message STR(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) " > 65535"
+#    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR must be less than 65536
+#endif
+
+// If DYNAMIC_KEYMAP_EEPROM_ADDR not explicitly defined in config.h,
+#ifndef DYNAMIC_KEYMAP_EEPROM_ADDR
+#    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
+#endif
+
+#ifdef DYNAMIC_KEYMAP_SPARSE_LAYERS
+// Layers from DYNAMIC_KEYMAP_DENSE_LAYER_COUNT upwards are stored as a bitmap of their non-transparent keys,
+// followed by a pool of DYNAMIC_KEYMAP_SPARSE_KEY_COUNT keycodes shared by all of them, in layer/row/column order
+#    ifndef DYNAMIC_KEYMAP_DENSE_LAYER_COUNT
+#        define DYNAMIC_KEYMAP_DENSE_LAYER_COUNT 1
+#    endif
+#    if DYNAMIC_KEYMAP_DENSE_LAYER_COUNT < 1 || DYNAMIC_KEYMAP_DENSE_LAYER_COUNT >= DYNAMIC_KEYMAP_LAYER_COUNT
+#        error DYNAMIC_KEYMAP_DENSE_LAYER_COUNT must be at least 1, and less than DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+#    define DYNAMIC_KEYMAP_SPARSE_KEYS ((DYNAMIC_KEYMAP_LAYER_COUNT - DYNAMIC_KEYMAP_DENSE_LAYER_COUNT) * MATRIX_ROWS * MATRIX_COLS)
+#    ifndef DYNAMIC_KEYMAP_SPARSE_KEY_COUNT
+#        define DYNAMIC_KEYMAP_SPARSE_KEY_COUNT (DYNAMIC_KEYMAP_SPARSE_KEYS / 4)
+#    endif
+#    define DYNAMIC_KEYMAP_SPARSE_BITMAP_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_DENSE_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
+#    define DYNAMIC_KEYMAP_SPARSE_POOL_EEPROM_ADDR (DYNAMIC_KEYMAP_SPARSE_BITMAP_EEPROM_ADDR + ((DYNAMIC_KEYMAP_SPARSE_KEYS + 7) / 8))
+#    define DYNAMIC_KEYMAP_KEYMAP_EEPROM_SIZE ((DYNAMIC_KEYMAP_SPARSE_POOL_EEPROM_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR) + (DYNAMIC_KEYMAP_SPARSE_KEY_COUNT * 2))
+#else
+#    define DYNAMIC_KEYMAP_DENSE_LAYER_COUNT DYNAMIC_KEYMAP_LAYER_COUNT
+#    define DYNAMIC_KEYMAP_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#endif
+
+// Dynamic encoders starts after dynamic keymaps
+#ifndef DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR
+#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_KEYMAP_EEPROM_SIZE))
+#endif
+
+// Dynamic macro starts after dynamic encoders, but only when using ENCODER_MAP
+#ifdef ENCODER_MAP_ENABLE
+#    ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
+#        define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2))
+#    endif // DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
+#else      // ENCODER_MAP_ENABLE
+#    ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
+#        define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR)
+#    endif // DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
+#endif     // ENCODER_MAP_ENABLE
+
+// Dynamic macros are stored after the keymaps and use what is available
+// up to and including DYNAMIC_KEYMAP_EEPROM_MAX_ADDR.
+#ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
+#endif
@@ -19,6 +19,168 @@ void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#if defined(EECONFIG_RECORDS_ENABLE)
+#    include "crc.h"
+
+#    define EECONFIG_RECORD_NONE 0xFF
+
+// RAM copy of the core settings, so the accessors below don't go back to EEPROM
+static uint8_t eeconfig_cache[EECONFIG_BASE_SIZE];
+static bool    eeconfig_loaded = false;
+
+// A datablock image is laid out as data, version (little endian), sequence number, then the CRC8 of all that precedes it.
+// Both copies use the same layout, and an update always overwrites the copy not holding the current image.
+typedef struct {
+    uint8_t *address;
+    uint8_t *image;
+    uint16_t size;
+    uint32_t version;
+    uint8_t  active; // copy the image was last read from or written to
+} eeconfig_record_t;
+
+#    if (EECONFIG_KB_DATA_SIZE) > 0
+static uint8_t           kb_record_image[(EECONFIG_KB_DATA_SIZE) + EECONFIG_RECORD_OVERHEAD];
+static eeconfig_record_t kb_record = {EECONFIG_KB_DATABLOCK, kb_record_image, (EECONFIG_KB_DATA_SIZE), (EECONFIG_KB_DATA_VERSION), EECONFIG_RECORD_NONE};
+#    endif
+#    if (EECONFIG_USER_DATA_SIZE) > 0
+static uint8_t           user_record_image[(EECONFIG_USER_DATA_SIZE) + EECONFIG_RECORD_OVERHEAD];
+static eeconfig_record_t user_record = {EECONFIG_USER_DATABLOCK, user_record_image, (EECONFIG_USER_DATA_SIZE), (EECONFIG_USER_DATA_VERSION), EECONFIG_RECORD_NONE};
+#    endif
+
+static uint8_t *eeconfig_record_copy(eeconfig_record_t *record, uint8_t copy) {
+    return record->address + copy * (record->size + EECONFIG_RECORD_OVERHEAD);
+}
+
+static bool eeconfig_record_image_is_valid(eeconfig_record_t *record) {
+    uint8_t *trailer = record->image + record->size;
+    uint32_t version = trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+    return version == record->version && crc8(record->image, record->size + 5) == trailer[5];
+}
+
+static void eeconfig_record_load(eeconfig_record_t *record) {
+    // Only the sequence numbers are needed to pick a copy, the older one is read in full only when the newer one is bad
+    uint8_t sequence[2];
+    for (uint8_t copy = 0; copy < 2; copy++) {
+        sequence[copy] = eeprom_read_byte(eeconfig_record_copy(record, copy) + record->size + 4);
+    }
+    uint8_t newest = (int8_t)(sequence[1] - sequence[0]) > 0 ? 1 : 0;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        record->active = newest ^ i;
+        eeprom_read_block(record->image, eeconfig_record_copy(record, record->active), record->size + EECONFIG_RECORD_OVERHEAD);
+        if (eeconfig_record_image_is_valid(record)) {
+            return;
+        }
+    }
+    record->active = EECONFIG_RECORD_NONE;
+}
+
+static void eeconfig_record_read(eeconfig_record_t *record, void *data) {
+    if (record->active != EECONFIG_RECORD_NONE) {
+        memcpy(data, record->image, record->size);
+    } else {
+        memset(data, 0, record->size);
+    }
+}
+
+static void eeconfig_record_update(eeconfig_record_t *record, const void *data) {
+    if (record->active != EECONFIG_RECORD_NONE && memcmp(record->image, data, record->size) == 0) {
+        return;
+    }
+
+    uint8_t *trailer = record->image + record->size;
+    trailer[4]       = record->active != EECONFIG_RECORD_NONE ? trailer[4] + 1 : 0;
+    memcpy(record->image, data, record->size);
+    trailer[0] = record->version & 0xFF;
+    trailer[1] = (record->version >> 8) & 0xFF;
+    trailer[2] = (record->version >> 16) & 0xFF;
+    trailer[3] = (record->version >> 24) & 0xFF;
+    trailer[5] = crc8(record->image, record->size + 5);
+
+    // Power loss part way through leaves the other copy, with the previous contents, to be picked up on the next load
+    record->active = record->active == 0 ? 1 : 0;
+    eeprom_update_block(record->image, eeconfig_record_copy(record, record->active), record->size + EECONFIG_RECORD_OVERHEAD);
+}
+
+/** \brief eeconfig load
+ *
+ * Reads the core settings and validates every datablock in a single pass. Reads are served from RAM afterwards.
+ * Called once at startup, and again whenever the EEPROM has been erased.
+ */
+void eeconfig_load(void) {
+    eeprom_read_block(eeconfig_cache, EECONFIG_MAGIC, EECONFIG_BASE_SIZE);
+#    if (EECONFIG_KB_DATA_SIZE) > 0
+    eeconfig_record_load(&kb_record);
+#    endif
+#    if (EECONFIG_USER_DATA_SIZE) > 0
+    eeconfig_record_load(&user_record);
+#    endif
+    eeconfig_loaded = true;
+}
+
+static void eeconfig_cache_read(void *value, const void *addr, size_t size) {
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    memcpy(value, eeconfig_cache + (uintptr_t)addr, size);
+}
+
+static void eeconfig_cache_update(const void *value, void *addr, size_t size) {
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    memcpy(eeconfig_cache + (uintptr_t)addr, value, size);
+    eeprom_update_block(value, addr, size);
+}
+
+static uint8_t cached_read_byte(const uint8_t *addr) {
+    uint8_t value;
+    eeconfig_cache_read(&value, addr, sizeof(value));
+    return value;
+}
+
+static uint16_t cached_read_word(const uint16_t *addr) {
+    uint16_t value;
+    eeconfig_cache_read(&value, addr, sizeof(value));
+    return value;
+}
+
+static uint32_t cached_read_dword(const uint32_t *addr) {
+    uint32_t value;
+    eeconfig_cache_read(&value, addr, sizeof(value));
+    return value;
+}
+
+static void cached_update_byte(uint8_t *addr, uint8_t value) {
+    eeconfig_cache_update(&value, addr, sizeof(value));
+}
+
+static void cached_update_word(uint16_t *addr, uint16_t value) {
+    eeconfig_cache_update(&value, addr, sizeof(value));
+}
+
+static void cached_update_dword(uint32_t *addr, uint32_t value) {
+    eeconfig_cache_update(&value, addr, sizeof(value));
+}
+#else
+#    define cached_read_byte eeprom_read_byte
+#    define cached_read_word eeprom_read_word
+#    define cached_read_dword eeprom_read_dword
+#    define cached_update_byte eeprom_update_byte
+#    define cached_update_word eeprom_update_word
+#    define cached_update_dword eeprom_update_dword
+#endif
+
+static void eeconfig_erase(void) {
+#if defined(EEPROM_DRIVER)
+    eeprom_driver_erase();
+#endif
+#if defined(EECONFIG_RECORDS_ENABLE)
+    // Drop anything cached from before the erase
+    eeconfig_load();
+#endif
+}
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -43,18 +205,16 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
  * FIXME: needs doc
  */
 void eeconfig_init_quantum(void) {
-#if defined(EEPROM_DRIVER)
-    eeprom_driver_erase();
-#endif
+    eeconfig_erase();
 
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
-    eeprom_update_byte(EECONFIG_DEBUG, 0);
+    cached_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    cached_update_byte(EECONFIG_DEBUG, 0);
     default_layer_state = (layer_state_t)1 << 0;
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, default_layer_state);
+    cached_update_byte(EECONFIG_DEFAULT_LAYER, default_layer_state);
     // Enable oneshot and autocorrect by default: 0b0001 0100 0000 0000
-    eeprom_update_word(EECONFIG_KEYMAP, 0x1400);
+    cached_update_word(EECONFIG_KEYMAP, 0x1400);
     eeprom_update_byte(EECONFIG_BACKLIGHT, 0);
-    eeprom_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
+    cached_update_byte(EECONFIG_AUDIO, 0xFF); // On by default
     eeprom_update_dword(EECONFIG_RGBLIGHT, 0);
     eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
     eeprom_update_byte(EECONFIG_UNUSED, 0);
@@ -62,7 +222,7 @@ void eeconfig_init_quantum(void) {
     eeprom_update_byte(EECONFIG_STENOMODE, 0);
     uint64_t dummy = 0;
     eeprom_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
+    cached_update_dword(EECONFIG_HAPTIC, 0);
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
@@ -99,7 +259,7 @@ void eeconfig_init(void) {
  * FIXME: needs doc
  */
 void eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    cached_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
 }
 
 /** \brief eeconfig disable
@@ -107,10 +267,8 @@ void eeconfig_enable(void) {
  * FIXME: needs doc
  */
 void eeconfig_disable(void) {
-#if defined(EEPROM_DRIVER)
-    eeprom_driver_erase();
-#endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_erase();
+    cached_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
 }
 
 /** \brief eeconfig is enabled
@@ -118,7 +276,7 @@ void eeconfig_disable(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_enabled(void) {
-    bool is_eeprom_enabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
+    bool is_eeprom_enabled = (cached_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
 #ifdef VIA_ENABLE
     if (is_eeprom_enabled) {
         is_eeprom_enabled = via_eeprom_is_valid();
@@ -132,7 +290,7 @@ bool eeconfig_is_enabled(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_disabled(void) {
-    bool is_eeprom_disabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
+    bool is_eeprom_disabled = (cached_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
 #ifdef VIA_ENABLE
     if (!is_eeprom_disabled) {
         is_eeprom_disabled = !via_eeprom_is_valid();
@@ -146,14 +304,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return cached_read_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    cached_update_byte(EECONFIG_DEBUG, val);
 }
 
 /** \brief eeconfig read default layer
@@ -161,14 +319,14 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_default_layer(void) {
-    return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    return cached_read_byte(EECONFIG_DEFAULT_LAYER);
 }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
 void eeconfig_update_default_layer(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    cached_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 /** \brief eeconfig read keymap
@@ -176,14 +334,14 @@ void eeconfig_update_default_layer(uint8_t val) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return eeprom_read_word(EECONFIG_KEYMAP);
+    return cached_read_word(EECONFIG_KEYMAP);
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_word(EECONFIG_KEYMAP, val);
+    cached_update_word(EECONFIG_KEYMAP, val);
 }
 
 /** \brief eeconfig read audio
@@ -191,14 +349,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return cached_read_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    cached_update_byte(EECONFIG_AUDIO, val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
@@ -207,14 +365,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return cached_read_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    cached_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
@@ -224,14 +382,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return cached_read_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    cached_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
@@ -240,14 +398,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return cached_read_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    cached_update_dword(EECONFIG_HAPTIC, val);
 }
 
 /** \brief eeconfig read split handedness
@@ -255,14 +413,14 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!cached_read_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    cached_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
@@ -271,26 +429,47 @@ void eeconfig_update_handedness(bool val) {
  * FIXME: needs doc
  */
 bool eeconfig_is_kb_datablock_valid(void) {
+#    if defined(EECONFIG_RECORDS_ENABLE)
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    return kb_record.active != EECONFIG_RECORD_NONE;
+#    else
     return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+#    endif
 }
 /** \brief eeconfig read keyboard data block
  *
  * FIXME: needs doc
  */
 void eeconfig_read_kb_datablock(void *data) {
+#    if defined(EECONFIG_RECORDS_ENABLE)
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    eeconfig_record_read(&kb_record, data);
+#    else
     if (eeconfig_is_kb_datablock_valid()) {
         eeprom_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_KB_DATA_SIZE));
     }
+#    endif
 }
 /** \brief eeconfig update keyboard data block
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb_datablock(const void *data) {
+#    if defined(EECONFIG_RECORDS_ENABLE)
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    eeconfig_record_update(&kb_record, data);
+#    else
     eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
     eeprom_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+#    endif
 }
 /** \brief eeconfig init keyboard data block
  *
@@ -308,26 +487,47 @@ __attribute__((weak)) void eeconfig_init_kb_datablock(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_user_datablock_valid(void) {
+#    if defined(EECONFIG_RECORDS_ENABLE)
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    return user_record.active != EECONFIG_RECORD_NONE;
+#    else
     return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+#    endif
 }
 /** \brief eeconfig read user data block
  *
  * FIXME: needs doc
  */
 void eeconfig_read_user_datablock(void *data) {
+#    if defined(EECONFIG_RECORDS_ENABLE)
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    eeconfig_record_read(&user_record, data);
+#    else
     if (eeconfig_is_user_datablock_valid()) {
         eeprom_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_USER_DATA_SIZE));
     }
+#    endif
 }
 /** \brief eeconfig update user data block
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user_datablock(const void *data) {
+#    if defined(EECONFIG_RECORDS_ENABLE)
+    if (!eeconfig_loaded) {
+        eeconfig_load();
+    }
+    eeconfig_record_update(&user_record, data);
+#    else
     eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
     eeprom_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+#    endif
 }
 /** \brief eeconfig init user data block
  *
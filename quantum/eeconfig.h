@@ -65,11 +65,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define EECONFIG_USER_DATA_VERSION (EECONFIG_USER_DATA_SIZE)
 #endif
 
+#ifdef EECONFIG_RECORDS_ENABLE
+// Datablocks are stored as two copies, each followed by its version, a sequence number and a CRC8
+#    define EECONFIG_RECORD_OVERHEAD 6
+#    define EECONFIG_RECORD_STORAGE_SIZE(size) ((size) > 0 ? 2 * ((size) + EECONFIG_RECORD_OVERHEAD) : 0)
+#else
+#    define EECONFIG_RECORD_STORAGE_SIZE(size) (size)
+#endif
+
 #define EECONFIG_KB_DATABLOCK ((uint8_t *)(EECONFIG_BASE_SIZE))
-#define EECONFIG_USER_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE)))
+#define EECONFIG_USER_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + EECONFIG_RECORD_STORAGE_SIZE(EECONFIG_KB_DATA_SIZE)))
 
 // Size of EEPROM being used, other code can refer to this for available EEPROM
-#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE))
+#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + EECONFIG_RECORD_STORAGE_SIZE(EECONFIG_KB_DATA_SIZE) + EECONFIG_RECORD_STORAGE_SIZE(EECONFIG_USER_DATA_SIZE))
 
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
@@ -97,6 +105,10 @@ void eeconfig_init_user(void);
 
 void eeconfig_enable(void);
 
+#ifdef EECONFIG_RECORDS_ENABLE
+void eeconfig_load(void);
+#endif
+
 void eeconfig_disable(void);
 
 uint8_t eeconfig_read_debug(void);
@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "action_util.h"
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
 #endif
@@ -81,6 +82,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
+#ifdef BOOT_PROFILE_ENABLE
+#    include "boot_profile.h"
+#endif
 #ifdef POINTING_DEVICE_ENABLE
 #    include "pointing_device.h"
 #endif
@@ -102,6 +106,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
+#ifdef SEND_STRING_ENABLE
+#    include "send_string.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -197,6 +210,10 @@ void matrix_scan_perf_task(void) {
     if (TIMER_DIFF_32(timer_now, matrix_timer) >= 1000) {
 #    if defined(CONSOLE_ENABLE)
         dprintf("matrix scan frequency: %lu\n", matrix_scan_count);
+#        if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_RENDER_GOVERNOR)
+        rgb_matrix_budget_t budget = rgb_matrix_get_budget();
+        dprintf("rgb matrix budget: %u leds/task, %u ms/frame, %u us/task\n", budget.process_limit, budget.flush_limit, budget.loop_us);
+#        endif
 #    endif
         last_matrix_scan_count = matrix_scan_count;
         matrix_timer           = timer_now;
@@ -297,6 +314,87 @@ __attribute__((weak)) void keyboard_post_init_kb(void) {
     keyboard_post_init_user();
 }
 
+/** \brief keyboard_deferred_init_user
+ *
+ * Called once, when the matrix has settled after startup and any key held then has been reported, see keyboard_deferred_init_ready().
+ */
+__attribute__((weak)) void keyboard_deferred_init_user(void) {}
+
+/** \brief keyboard_deferred_init_kb
+ *
+ * Called once, when the matrix has settled after startup and any key held then has been reported, see keyboard_deferred_init_ready().
+ */
+__attribute__((weak)) void keyboard_deferred_init_kb(void) {
+    keyboard_deferred_init_user();
+}
+
+#ifndef KEYBOARD_DEFERRED_INIT_IDLE
+// Long enough for a key held at power up to get through debounce and be reported
+#    ifdef DEBOUNCE
+#        define KEYBOARD_DEFERRED_INIT_IDLE (DEBOUNCE * 2)
+#    else
+#        define KEYBOARD_DEFERRED_INIT_IDLE 10
+#    endif
+#endif
+
+#ifndef KEYBOARD_DEFERRED_INIT_TIMEOUT
+#    define KEYBOARD_DEFERRED_INIT_TIMEOUT 500
+#endif
+
+static bool     deferred_init_done       = false;
+static uint32_t deferred_init_wait_start = 0;
+
+/** \brief keyboard_deferred_init_wait
+ *
+ * Holds deferred initialisation back again until the matrix settles, e.g. after waking up from a low power mode.
+ */
+void keyboard_deferred_init_wait(void) {
+    deferred_init_wait_start = sync_timer_read32();
+}
+
+/** \brief keyboard_deferred_init_ready
+ *
+ * Whether the matrix has stayed idle for KEYBOARD_DEFERRED_INIT_IDLE since startup or keyboard_deferred_init_wait(), so a key held at that point has been reported, or KEYBOARD_DEFERRED_INIT_TIMEOUT has passed.
+ */
+bool keyboard_deferred_init_ready(void) {
+    uint32_t waited = sync_timer_elapsed32(deferred_init_wait_start);
+    if (waited >= KEYBOARD_DEFERRED_INIT_TIMEOUT) {
+        return true;
+    }
+    return waited >= KEYBOARD_DEFERRED_INIT_IDLE && last_matrix_activity_elapsed() >= KEYBOARD_DEFERRED_INIT_IDLE;
+}
+
+#ifdef KEYBOARD_DEFERRED_INIT
+// LED drivers can take tens of milliseconds to bring up, don't hold the first keystroke back for them
+#    define LED_DRIVERS_READY() (deferred_init_done)
+#else
+#    define LED_DRIVERS_READY() (true)
+#endif
+
+static void led_drivers_init(void) {
+#ifdef LED_MATRIX_ENABLE
+    led_matrix_init();
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_init();
+#endif
+}
+
+/** \brief keyboard_deferred_init
+ *
+ * Runs initialisation that isn't needed to get the first keystroke to the host, see KEYBOARD_DEFERRED_INIT.
+ */
+static void keyboard_deferred_init(void) {
+#ifdef KEYBOARD_DEFERRED_INIT
+    led_drivers_init();
+#endif
+    keyboard_deferred_init_kb();
+    deferred_init_done = true;
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_DEFERRED_INIT);
+#endif
+}
+
 /** \brief matrix_can_read
  *
  * Allows overriding when matrix scanning operations should be executed.
@@ -310,9 +408,18 @@ __attribute__((weak)) bool matrix_can_read(void) {
  * FIXME: needs doc
  */
 void keyboard_setup(void) {
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_start(BOOT_REASON_RESET);
+#endif
     print_set_sendchar(sendchar);
 #ifdef EEPROM_DRIVER
     eeprom_driver_init();
+#endif
+#ifdef EECONFIG_RECORDS_ENABLE
+    eeconfig_load();
+#endif
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_EEPROM_READY);
 #endif
     matrix_setup();
     keyboard_pre_init_kb();
@@ -368,6 +475,10 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
 void housekeeping_task(void) {
     housekeeping_task_kb();
     housekeeping_task_user();
+
+    if (!deferred_init_done && keyboard_deferred_init_ready()) {
+        keyboard_deferred_init();
+    }
 }
 
 /** \brief Init tasks previously located in matrix_init_quantum
@@ -383,11 +494,8 @@ void quantum_init(void) {
 #ifdef AUDIO_ENABLE
     audio_init();
 #endif
-#ifdef LED_MATRIX_ENABLE
-    led_matrix_init();
-#endif
-#ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_init();
+#ifndef KEYBOARD_DEFERRED_INIT
+    led_drivers_init();
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
     unicode_input_mode_init();
@@ -401,6 +509,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_KEYBOARD_INIT);
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -411,7 +522,13 @@ void keyboard_init(void) {
     encoder_init();
 #endif
     matrix_init();
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_MATRIX_READY);
+#endif
     quantum_init();
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_QUANTUM_READY);
+#endif
 #if defined(CRC_ENABLE)
     crc_init();
 #endif
@@ -465,6 +582,9 @@ void keyboard_init(void) {
 #endif
 
     keyboard_post_init_kb(); /* Always keep this last */
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_POST_INIT);
+#endif
 }
 
 /** \brief key_event_task
@@ -529,6 +649,11 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
+#ifdef KEYBOARD_REPORT_BATCHING
+    // Send the report changes of this scan together once all keys are processed
+    keyboard_report_batch_begin();
+#endif
+
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
         const matrix_row_t row_changes = current_row ^ matrix_previous[row];
@@ -553,6 +678,10 @@ static bool matrix_task(void) {
         matrix_previous[row] = current_row;
     }
 
+#ifdef KEYBOARD_REPORT_BATCHING
+    keyboard_report_batch_end();
+#endif
+
     return matrix_changed;
 }
 
@@ -629,6 +758,22 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#ifdef SEND_STRING_ENABLE
+    send_string_async_task();
+#endif
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_macro_task();
+#endif
+
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
+#if defined(EEPROM_WRITE_BACK) || defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION) || defined(FEE_CHECKPOINTED_COMPACTION)
+    eeprom_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -638,6 +783,9 @@ void keyboard_task(void) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_FIRST_SCAN);
+#endif
 
     quantum_task();
 
@@ -650,10 +798,10 @@ void keyboard_task(void) {
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    if (LED_DRIVERS_READY()) led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    if (LED_DRIVERS_READY()) rgb_matrix_task();
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
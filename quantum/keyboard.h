@@ -107,6 +107,10 @@ void keyboard_pre_init_kb(void);
 void keyboard_pre_init_user(void);
 void keyboard_post_init_kb(void);
 void keyboard_post_init_user(void);
+void keyboard_deferred_init_kb(void);
+void keyboard_deferred_init_user(void);
+void keyboard_deferred_init_wait(void);
+bool keyboard_deferred_init_ready(void);
 
 void housekeeping_task(void);      // To be executed by the main loop in each backend TMK protocol
 void housekeeping_task_kb(void);   // To be overridden by keyboard-level code
@@ -91,3 +91,28 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
 }
 
 #endif // defined(COMBO_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
+
+#    define NUM_LEADER_SEQUENCES_RAW ((uint16_t)(sizeof(leader_sequences) / sizeof(leader_sequence_t)))
+
+_Static_assert(NUM_LEADER_SEQUENCES_RAW <= LEADER_SEQUENCE_TABLE_LENGTH, "Number of leader sequences exceeds LEADER_SEQUENCE_TABLE_LENGTH");
+
+uint16_t leader_sequence_count_raw(void) {
+    return NUM_LEADER_SEQUENCES_RAW;
+}
+__attribute__((weak)) uint16_t leader_sequence_count(void) {
+    return leader_sequence_count_raw();
+}
+
+const leader_sequence_t* leader_sequence_get_raw(uint16_t sequence_idx) {
+    return &leader_sequences[sequence_idx];
+}
+__attribute__((weak)) const leader_sequence_t* leader_sequence_get(uint16_t sequence_idx) {
+    return leader_sequence_get_raw(sequence_idx);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
@@ -7,6 +7,11 @@
 
 #include <string.h>
 
+#ifdef LEADER_SEQUENCE_TABLE
+#    include "quantum.h"
+#    include "keymap_introspection.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
@@ -17,6 +22,117 @@ uint16_t leader_time          = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#ifdef LEADER_SEQUENCE_TABLE
+_Static_assert(LEADER_SEQUENCE_TABLE_LENGTH <= UINT8_MAX, "LEADER_SEQUENCE_TABLE_LENGTH must fit in a uint8_t");
+
+// Table indices sorted by sequence, so all sequences sharing a prefix are
+// adjacent and the sequences that can still match form a single run.
+static uint8_t leader_table_order[LEADER_SEQUENCE_TABLE_LENGTH];
+static uint8_t leader_table_count  = 0;
+static bool    leader_table_sorted = false;
+static uint8_t leader_table_low    = 0;
+static uint8_t leader_table_high   = 0;
+
+static uint16_t leader_table_key(uint8_t index, uint8_t key) {
+    if (key >= ARRAY_SIZE(leader_sequence)) {
+        return KC_NO;
+    }
+    return pgm_read_word(&leader_sequence_get(index)->sequence[key]);
+}
+
+static int8_t leader_table_compare(uint8_t a, uint8_t b) {
+    for (uint8_t key = 0; key < ARRAY_SIZE(leader_sequence); key++) {
+        uint16_t kc_a = leader_table_key(a, key);
+        uint16_t kc_b = leader_table_key(b, key);
+        if (kc_a != kc_b) {
+            return kc_a < kc_b ? -1 : 1;
+        }
+        if (kc_a == KC_NO) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static void leader_table_sort(void) {
+    uint16_t count = leader_sequence_count();
+    if (count > LEADER_SEQUENCE_TABLE_LENGTH) {
+        dprintf("leader: %u sequences exceed LEADER_SEQUENCE_TABLE_LENGTH, ignoring the rest\n", count);
+        count = LEADER_SEQUENCE_TABLE_LENGTH;
+    }
+
+    // Insertion sort, which is stable so the first duplicate in the table wins
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t j = i;
+        while (j > 0 && leader_table_compare(i, leader_table_order[j - 1]) < 0) {
+            leader_table_order[j] = leader_table_order[j - 1];
+            j--;
+        }
+        leader_table_order[j] = i;
+    }
+
+    leader_table_count  = count;
+    leader_table_sorted = true;
+}
+
+// First position in the current run whose key at `key` is above `keycode`,
+// or not below it if `upper` is false.
+static uint8_t leader_table_bound(uint8_t key, uint16_t keycode, bool upper) {
+    uint8_t low  = leader_table_low;
+    uint8_t high = leader_table_high;
+    while (low < high) {
+        uint8_t  mid = low + (high - low) / 2;
+        uint16_t kc  = leader_table_key(leader_table_order[mid], key);
+        if (kc < keycode || (upper && kc == keycode)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void leader_table_narrow(uint16_t keycode) {
+    uint8_t key = leader_sequence_size - 1;
+    if (keycode == KC_NO) {
+        leader_table_high = leader_table_low;
+        return;
+    }
+    uint8_t low       = leader_table_bound(key, keycode, false);
+    leader_table_high = leader_table_bound(key, keycode, true);
+    leader_table_low  = low;
+}
+
+// The shortest sequence sorts first, so only the start of the run can be an
+// exact match for the buffer.
+static bool leader_table_matched(void) {
+    return leader_sequence_size > 0 && leader_table_low < leader_table_high && leader_table_key(leader_table_order[leader_table_low], leader_sequence_size) == KC_NO;
+}
+
+static void leader_table_perform(void) {
+    if (!leader_table_matched()) {
+        return;
+    }
+
+    const leader_sequence_t *entry = leader_sequence_get(leader_table_order[leader_table_low]);
+    switch (pgm_read_byte(&entry->action)) {
+        case LEADER_ACTION_KEYCODE:
+            tap_code16(pgm_read_word(&entry->keycode));
+            break;
+#    ifdef SEND_STRING_ENABLE
+        case LEADER_ACTION_STRING:
+            send_string((const char *)pgm_read_ptr(&entry->string));
+            break;
+#    endif
+        case LEADER_ACTION_CALLBACK: {
+            void (*callback)(void) = (void (*)(void))pgm_read_ptr(&entry->callback);
+            callback();
+            break;
+        }
+    }
+}
+#endif
+
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
@@ -30,10 +146,21 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+
+#ifdef LEADER_SEQUENCE_TABLE
+    if (!leader_table_sorted) {
+        leader_table_sort();
+    }
+    leader_table_low  = 0;
+    leader_table_high = leader_table_count;
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_table_perform();
+#endif
     leader_end_user();
 }
 
@@ -61,6 +188,10 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_table_narrow(keycode);
+#endif
+
     return true;
 }
 
@@ -72,6 +203,14 @@ bool leader_sequence_timed_out(void) {
 #endif
 }
 
+bool leader_sequence_resolved(void) {
+#ifdef LEADER_SEQUENCE_TABLE
+    return leader_table_high - leader_table_low == 1 && leader_table_matched();
+#else
+    return false;
+#endif
+}
+
 void leader_reset_timer(void) {
     leader_time = timer_read();
 }
@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,42 @@
  * \{
  */
 
+#ifdef LEADER_SEQUENCE_TABLE
+
+#    ifndef LEADER_SEQUENCE_TABLE_LENGTH
+#        define LEADER_SEQUENCE_TABLE_LENGTH 32
+#    endif
+
+typedef enum {
+    LEADER_ACTION_KEYCODE,
+    LEADER_ACTION_STRING,
+    LEADER_ACTION_CALLBACK,
+} leader_action_t;
+
+/**
+ * \brief An entry of the `leader_sequences` table.
+ *
+ * Unused trailing keys of the sequence are left as `KC_NO`.
+ */
+typedef struct leader_sequence_t {
+    uint16_t sequence[5];
+    uint8_t  action;
+    union {
+        uint16_t    keycode;
+        const char *string;
+        void (*callback)(void);
+    };
+} leader_sequence_t;
+
+#    define LEADER_SEQUENCE_KEYCODE(kc, ...) \
+        { .sequence = {__VA_ARGS__}, .action = LEADER_ACTION_KEYCODE, .keycode = (kc) }
+#    define LEADER_SEQUENCE_STRING(str, ...) \
+        { .sequence = {__VA_ARGS__}, .action = LEADER_ACTION_STRING, .string = (str) }
+#    define LEADER_SEQUENCE_CALLBACK(fn, ...) \
+        { .sequence = {__VA_ARGS__}, .action = LEADER_ACTION_CALLBACK, .callback = (fn) }
+
+#endif
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -56,6 +94,15 @@ bool leader_sequence_add(uint16_t keycode);
  */
 bool leader_sequence_timed_out(void);
 
+/**
+ * Whether the sequence buffer matches a sequence of the leader table that no
+ * other table sequence extends, so the sequence can end without waiting for
+ * the timeout.
+ *
+ * Always `false` unless `LEADER_SEQUENCE_TABLE` is defined.
+ */
+bool leader_sequence_resolved(void);
+
 /**
  * Reset the leader sequence timer.
  */
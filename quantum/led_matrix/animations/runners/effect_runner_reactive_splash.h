@@ -4,10 +4,18 @@
 
 typedef uint8_t (*reactive_splash_f)(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Runs effect_func for every hit from start onwards, skipping hits whose scaled tick has reached
+// horizon: the tick after which the effect no longer lights any LED, whatever its distance
+bool effect_runner_reactive_splash_horizon(uint8_t start, uint16_t horizon, effect_params_t* params, reactive_splash_f effect_func) {
     LED_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t ticks[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        ticks[j] = scale16by8(g_last_hit_tracker.tick[j], led_matrix_eeconfig.speed);
+        // Hits are ordered oldest first, so the faded out ones form a prefix
+        if (ticks[j] >= horizon) start = j + 1;
+    }
     for (uint8_t i = led_min; i < led_max; i++) {
         LED_MATRIX_TEST_LED_FLAGS();
         uint8_t val = 0;
@@ -15,12 +23,15 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
             int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
             int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
             uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], led_matrix_eeconfig.speed);
-            val           = effect_func(val, dx, dy, dist, tick);
+            val           = effect_func(val, dx, dy, dist, ticks[j]);
         }
         led_matrix_set_value(i, scale8(val, led_matrix_eeconfig.val));
     }
     return led_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_horizon(start, UINT16_MAX, params, effect_func);
+}
+
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
@@ -11,6 +11,9 @@ LED_MATRIX_EFFECT(SOLID_REACTIVE_MULTICROSS)
 
 #        ifdef LED_MATRIX_CUSTOM_EFFECT_IMPLS
 
+// Past this tick the effect has faded out at any distance
+#            define SOLID_REACTIVE_CROSS_HORIZON (255)
+
 static uint8_t SOLID_REACTIVE_CROSS_math(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     uint16_t effect = tick + dist;
     dx              = dx < 0 ? dx * -1 : dx;
@@ -24,13 +27,13 @@ static uint8_t SOLID_REACTIVE_CROSS_math(uint8_t val, int16_t dx, int16_t dy, ui
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
 bool SOLID_REACTIVE_CROSS(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_CROSS_math);
+    return effect_runner_reactive_splash_horizon(qsub8(g_last_hit_tracker.count, 1), SOLID_REACTIVE_CROSS_HORIZON, params, &SOLID_REACTIVE_CROSS_math);
 }
 #            endif
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
 bool SOLID_REACTIVE_MULTICROSS(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_CROSS_math);
+    return effect_runner_reactive_splash_horizon(0, SOLID_REACTIVE_CROSS_HORIZON, params, &SOLID_REACTIVE_CROSS_math);
 }
 #            endif
 
@@ -11,6 +11,9 @@ LED_MATRIX_EFFECT(SOLID_REACTIVE_MULTIWIDE)
 
 #        ifdef LED_MATRIX_CUSTOM_EFFECT_IMPLS
 
+// Past this tick the effect has faded out at any distance
+#            define SOLID_REACTIVE_WIDE_HORIZON (255)
+
 static uint8_t SOLID_REACTIVE_WIDE_math(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     uint16_t effect = tick + dist * 5;
     if (effect > 255) effect = 255;
@@ -19,13 +22,13 @@ static uint8_t SOLID_REACTIVE_WIDE_math(uint8_t val, int16_t dx, int16_t dy, uin
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
 bool SOLID_REACTIVE_WIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_horizon(qsub8(g_last_hit_tracker.count, 1), SOLID_REACTIVE_WIDE_HORIZON, params, &SOLID_REACTIVE_WIDE_math);
 }
 #            endif
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
 bool SOLID_REACTIVE_MULTIWIDE(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_REACTIVE_WIDE_math);
+    return effect_runner_reactive_splash_horizon(0, SOLID_REACTIVE_WIDE_HORIZON, params, &SOLID_REACTIVE_WIDE_math);
 }
 #            endif
 
@@ -11,6 +11,9 @@ LED_MATRIX_EFFECT(SOLID_MULTISPLASH)
 
 #        ifdef LED_MATRIX_CUSTOM_EFFECT_IMPLS
 
+// Past this tick the effect has faded out at any distance
+#            define SOLID_SPLASH_HORIZON (255 + 255)
+
 uint8_t SOLID_SPLASH_math(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
     uint16_t effect = tick - dist;
     if (effect > 255) effect = 255;
@@ -19,13 +22,13 @@ uint8_t SOLID_SPLASH_math(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uin
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_SPLASH
 bool SOLID_SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_horizon(qsub8(g_last_hit_tracker.count, 1), SOLID_SPLASH_HORIZON, params, &SOLID_SPLASH_math);
 }
 #            endif
 
 #            ifdef ENABLE_LED_MATRIX_SOLID_MULTISPLASH
 bool SOLID_MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_horizon(0, SOLID_SPLASH_HORIZON, params, &SOLID_SPLASH_math);
 }
 #            endif
 
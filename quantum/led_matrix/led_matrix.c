@@ -75,6 +75,10 @@ last_hit_t g_last_hit_tracker;
 #ifdef LED_MATRIX_DRIVER_SHUTDOWN_ENABLE
 static bool driver_shutdown = false;
 #endif
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+// Brightness last written to the driver, out of range until the first flush
+static uint16_t driver_brightness = UINT16_MAX;
+#endif
 static bool            suspend_state     = false;
 static uint8_t         led_last_enable   = UINT8_MAX;
 static uint8_t         led_last_effect   = UINT8_MAX;
@@ -88,7 +92,7 @@ static uint32_t led_matrix_timeout = LED_MATRIX_TIMEOUT;
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+static last_hit_ring_t last_hit_buffer;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // split led matrix
@@ -182,21 +186,17 @@ void process_led_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    // Ring insert, the oldest hit is overwritten once the buffer is full
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
+        uint8_t index                = last_hit_buffer.head;
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        last_hit_buffer.time[index]  = led_timer_buffer;
+        last_hit_buffer.head         = (index + 1) % LED_HITS_TO_REMEMBER;
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            last_hit_buffer.count++;
+        }
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
@@ -227,9 +227,9 @@ static bool led_matrix_none(effect_params_t *params) {
 }
 
 static void led_task_timers(void) {
-#if defined(LED_MATRIX_KEYREACTIVE_ENABLED) || LED_MATRIX_TIMEOUT > 0
+#if LED_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
-#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED) || LED_MATRIX_TIMEOUT > 0
+#endif // LED_MATRIX_TIMEOUT > 0
     led_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -242,19 +242,30 @@ static void led_task_timers(void) {
         }
     }
 #endif // LED_MATRIX_TIMEOUT > 0
+}
 
-    // Update double buffer last hit timers
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+static void led_task_last_hit_snapshot(void) {
     uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+    uint8_t slot  = (last_hit_buffer.head + LED_HITS_TO_REMEMBER - count) % LED_HITS_TO_REMEMBER;
+
+    // Hits are stored oldest first, so expired ones can only ever be dropped from the tail
+    while (count > 0 && led_timer_buffer - last_hit_buffer.time[slot] >= UINT16_MAX) {
+        slot = (slot + 1) % LED_HITS_TO_REMEMBER;
+        count--;
+    }
+    last_hit_buffer.count = count;
+
+    g_last_hit_tracker.count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        g_last_hit_tracker.x[i]     = last_hit_buffer.x[slot];
+        g_last_hit_tracker.y[i]     = last_hit_buffer.y[slot];
+        g_last_hit_tracker.index[i] = last_hit_buffer.index[slot];
+        g_last_hit_tracker.tick[i]  = led_timer_buffer - last_hit_buffer.time[slot];
+        slot                        = (slot + 1) % LED_HITS_TO_REMEMBER;
     }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
+#endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 static void led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
@@ -269,7 +280,7 @@ static void led_task_start(void) {
     // update double buffers
     g_led_timer = led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    led_task_last_hit_snapshot();
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -340,6 +351,14 @@ static void led_task_flush(uint8_t effect) {
     }
 #endif
 
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    // effects render at full scale, the driver dims everything at once
+    uint8_t brightness = led_matrix_driver_global_brightness_kb(led_matrix_eeconfig.val);
+    if (brightness != driver_brightness) {
+        led_matrix_driver.set_global_brightness(brightness);
+        driver_brightness = brightness;
+    }
+#endif
     // update pwm buffers
     led_matrix_update_pwm_buffers();
 
@@ -371,15 +390,22 @@ void led_matrix_task(void) {
         case STARTING:
             led_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+            uint8_t val             = led_matrix_eeconfig.val;
+            led_matrix_eeconfig.val = UINT8_MAX;
+#endif
             led_task_render(effect);
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+            led_matrix_eeconfig.val = val;
+#endif
             if (effect) {
                 if (led_task_state == FLUSHING) {
                     led_matrix_indicators(); // ensure we only draw basic indicators once rendering is finished
                 }
                 led_matrix_indicators_advanced(&led_effect_params);
             }
-            break;
+        } break;
         case FLUSHING:
             led_task_flush(effect);
             break;
@@ -451,6 +477,9 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 
 void led_matrix_init(void) {
     led_matrix_driver.init();
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    driver_brightness = UINT16_MAX;
+#endif
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -459,9 +488,7 @@ void led_matrix_init(void) {
     }
 
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+    last_hit_buffer.head  = 0;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     if (!eeconfig_is_enabled()) {
@@ -728,3 +755,13 @@ __attribute__((weak)) bool led_matrix_driver_allow_shutdown(void) {
     return true;
 };
 #endif
+
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+__attribute__((weak)) uint8_t led_matrix_driver_global_brightness_kb(uint8_t brightness) {
+    return led_matrix_driver_global_brightness_user(brightness);
+}
+
+__attribute__((weak)) uint8_t led_matrix_driver_global_brightness_user(uint8_t brightness) {
+    return brightness;
+}
+#endif
@@ -215,6 +215,10 @@ void led_matrix_driver_exit_shutdown(void);
 bool led_matrix_is_driver_shutdown(void);
 bool led_matrix_driver_allow_shutdown(void);
 #endif
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+uint8_t led_matrix_driver_global_brightness_kb(uint8_t brightness);
+uint8_t led_matrix_driver_global_brightness_user(uint8_t brightness);
+#endif
 
 typedef struct {
     /* Perform any initialisation required for the other driver functions to work. */
@@ -232,6 +236,10 @@ typedef struct {
     /* Exit from shutdown state. */
     void (*exit_shutdown)(void);
 #endif
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    /* Scale the output of all LEDs in hardware, 0 is off and 255 is full scale. */
+    void (*set_global_brightness)(uint8_t brightness);
+#endif
 } led_matrix_driver_t;
 
 static inline bool led_matrix_check_finished_leds(uint8_t led_idx) {
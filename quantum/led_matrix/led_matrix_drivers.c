@@ -25,6 +25,11 @@
  * in their own files.
  */
 
+// Only these drivers can scale their current, custom drivers provide set_global_brightness themselves
+#if defined(LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE) && !defined(LED_MATRIX_IS31FL3733) && !defined(LED_MATRIX_IS31FL3737) && !defined(LED_MATRIX_IS31FL3741) && !defined(LED_MATRIX_SNLED27351) && !defined(LED_MATRIX_SNLED27351_SPI) && !defined(LED_MATRIX_CUSTOM)
+#    error "LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE is not supported by this LED matrix driver"
+#endif
+
 #if defined(LED_MATRIX_IS31FL3218)
 const led_matrix_driver_t led_matrix_driver = {
     .init          = is31fl3218_init,
@@ -47,6 +52,9 @@ const led_matrix_driver_t led_matrix_driver = {
     .flush         = is31fl3733_flush,
     .set_value     = is31fl3733_set_value,
     .set_value_all = is31fl3733_set_value_all,
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = is31fl3733_set_global_brightness,
+#endif
 };
 
 #elif defined(LED_MATRIX_IS31FL3736)
@@ -63,6 +71,9 @@ const led_matrix_driver_t led_matrix_driver = {
     .flush         = is31fl3737_flush,
     .set_value     = is31fl3737_set_value,
     .set_value_all = is31fl3737_set_value_all,
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = is31fl3737_set_global_brightness,
+#endif
 };
 
 #elif defined(LED_MATRIX_IS31FL3741)
@@ -71,6 +82,9 @@ const led_matrix_driver_t led_matrix_driver = {
     .flush         = is31fl3741_flush,
     .set_value     = is31fl3741_set_value,
     .set_value_all = is31fl3741_set_value_all,
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = is31fl3741_set_global_brightness,
+#endif
 };
 
 #elif defined(IS31FLCOMMON)
@@ -91,6 +105,9 @@ const led_matrix_driver_t led_matrix_driver = {
     .shutdown      = snled27351_shutdown,
     .exit_shutdown = snled27351_exit_shutdown,
 #endif
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = snled27351_set_global_brightness,
+#endif
 };
 
 #elif defined(LED_MATRIX_SNLED27351_SPI)
@@ -103,6 +120,9 @@ const led_matrix_driver_t led_matrix_driver = {
     .shutdown      = snled27351_shutdown,
     .exit_shutdown = snled27351_exit_shutdown,
 #endif
+#ifdef LED_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = snled27351_set_global_brightness,
+#endif
 };
 
 #endif
@@ -37,6 +37,16 @@ typedef struct PACKED {
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
 } last_hit_t;
+
+// Ring of recent hits, stamped with the time they happened so they never need to be aged in place
+typedef struct PACKED {
+    uint8_t  head;
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint32_t time[LED_HITS_TO_REMEMBER];
+} last_hit_ring_t;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 typedef enum led_task_states { STARTING, RENDERING, FLUSHING, SYNCING } led_task_states;
@@ -22,6 +22,17 @@
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
+#ifdef AUTOCORRECT_AUTOMATON
+// Marks a node's stored failure link, never a typo keycode.
+#    define AUTOCORRECT_FAIL_LINK 63
+
+// Automaton state after each buffered keycode, so backspace can step back.
+// Only the first `typo_states_size` entries are current; the rest are
+// recomputed from `typo_buffer` on the next keypress.
+static uint16_t typo_states[AUTOCORRECT_MAX_LENGTH];
+static uint8_t  typo_states_size = 0;
+#endif
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -188,6 +199,143 @@ __attribute__((weak)) bool apply_autocorrect(uint8_t backspaces, const char *str
     return true;
 }
 
+#ifdef AUTOCORRECT_AUTOMATON
+/**
+ * @brief looks up a keycode in the transitions stored in one node
+ *
+ * @param state byte offset of the node in `autocorrect_data`
+ * @param keycode the basic keycode to look up
+ * @param fail set to the node's failure link, if the node stores one
+ * @return uint16_t byte offset of the next node, or 0 if there is none
+ */
+static uint16_t autocorrect_lookup(uint16_t state, uint8_t keycode, uint16_t *fail) {
+    for (uint8_t code; (code = pgm_read_byte(autocorrect_data + state)) != 0; state += 3) {
+        if ((code & 63) == keycode) {
+            if (code & 64) { // The last transition's node is stored right after it.
+                return state + 1;
+            }
+            return pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8;
+        }
+        if (code & 64) {
+            break;
+        }
+        if (code == AUTOCORRECT_FAIL_LINK) {
+            *fail = pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief advances the autocorrect automaton by one keycode
+ *
+ * Nodes only store their own children. For any other keycode the failure
+ * links are followed until a node has a transition for it, or the root is
+ * reached. Failure links that are not stored lead to the root's child for
+ * the keycode that entered the node, or to the root from that child itself.
+ *
+ * @param state byte offset of the current node in `autocorrect_data`
+ * @param last_keycode the keycode that led to the current node
+ * @param keycode the basic keycode being appended to the buffer
+ * @return uint16_t byte offset of the next node
+ */
+static uint16_t autocorrect_next_state(uint16_t state, uint8_t last_keycode, uint8_t keycode) {
+    for (;;) {
+        uint16_t fail = 0;
+        uint16_t next = autocorrect_lookup(state, keycode, &fail);
+        if (next || !state) {
+            return next;
+        }
+        if (!fail) {
+            uint16_t child = autocorrect_lookup(0, last_keycode, &fail);
+            fail           = child == state ? 0 : child;
+        }
+        state = fail;
+    }
+}
+
+/**
+ * @brief brings the automaton state up to date with `typo_buffer`
+ *
+ * Normally this is a single transition for the keycode that was just
+ * appended. States after a backspace or buffer reset are recomputed.
+ *
+ * @return uint16_t byte offset of the matched typo node, or 0 if none
+ */
+static uint16_t autocorrect_find_typo(void) {
+    if (typo_states_size >= typo_buffer_size) {
+        typo_states_size = typo_buffer_size - 1;
+    }
+
+    uint16_t state = typo_states_size ? typo_states[typo_states_size - 1] : 0;
+    for (; typo_states_size < typo_buffer_size; ++typo_states_size) {
+        if (pgm_read_byte(autocorrect_data + state) & 128) {
+            state = 0;
+        }
+        state = autocorrect_next_state(state, typo_states_size ? typo_buffer[typo_states_size - 1] : KC_NO, typo_buffer[typo_states_size]);
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            typo_states_size = 0;
+            return 0;
+        }
+        typo_states[typo_states_size] = state;
+    }
+
+    return (pgm_read_byte(autocorrect_data + state) & 128) ? state : 0;
+}
+#else
+/**
+ * @brief searches the end of `typo_buffer` for a typo
+ *
+ * Walks the reversed trie from the root over the buffer, newest keycode first.
+ * Kept for autocorrect_data.h files generated before the automaton format.
+ *
+ * @return uint16_t byte offset of the matched typo node, or 0 if none
+ */
+static uint16_t autocorrect_find_typo(void) {
+    // Return if buffer is smaller than the shortest word.
+    if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
+        return 0;
+    }
+
+    // Check for typo in buffer using a trie stored in `autocorrect_data`.
+    uint16_t state = 0;
+    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint8_t const key_i = typo_buffer[i];
+
+        if (code & 64) { // Check for match in node with multiple children.
+            code &= 63;
+            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+                if (!code) return 0;
+            }
+            // Follow link to child node.
+            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            // Check for match in node with single child.
+        } else if (code != key_i) {
+            return 0;
+        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+            ++state;
+        }
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            return 0;
+        }
+
+        code = pgm_read_byte(autocorrect_data + state);
+        if (code & 128) {
+            return state;
+        }
+
+    }
+    return 0;
+}
+#endif
+
 /**
  * @brief Process handler for autocorrect feature
  *
@@ -269,107 +417,87 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
     if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
         memmove(typo_buffer, typo_buffer + 1, AUTOCORRECT_MAX_LENGTH - 1);
         typo_buffer_size = AUTOCORRECT_MAX_LENGTH - 1;
+#ifdef AUTOCORRECT_AUTOMATON
+        if (typo_states_size > 0) {
+            memmove(typo_states, typo_states + 1, (AUTOCORRECT_MAX_LENGTH - 1) * sizeof(typo_states[0]));
+            --typo_states_size;
+        }
+#endif
     }
 
     // Append `keycode` to buffer.
     typo_buffer[typo_buffer_size++] = keycode;
-    // Return if buffer is smaller than the shortest word.
-    if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
+
+    // Check for a typo ending at the newest keycode.
+    uint16_t state = autocorrect_find_typo();
+    if (!state) {
         return true;
     }
 
-    // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
-
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
-            }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
-
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
-            return true;
+    // A typo was found! Apply autocorrect.
+    const uint8_t backspaces = (pgm_read_byte(autocorrect_data + state) & 63) + !record->event.pressed;
+    const char *  changes    = (const char *)(autocorrect_data + state + 1);
+
+    /* Gather info about the typo'd word
+     *
+     * Since buffer may contain several words, delimited by spaces, we
+     * iterate from the end to find the start and length of the typo
+     */
+    char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
+
+    uint8_t typo_len   = 0;
+    uint8_t typo_start = 0;
+    bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+    for (uint8_t i = typo_buffer_size; i > 0; --i) {
+        // stop counting after finding space (unless it is the last thing)
+        if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+            typo_start = i;
+            break;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
-
-        if (code & 128) { // A typo was found! Apply autocorrect.
-            const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char *  changes    = (const char *)(autocorrect_data + state + 1);
-
-            /* Gather info about the typo'd word
-             *
-             * Since buffer may contain several words, delimited by spaces, we
-             * iterate from the end to find the start and length of the typo
-             */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
-
-            uint8_t typo_len   = 0;
-            uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
-            for (uint8_t i = typo_buffer_size; i > 0; --i) {
-                // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
-                    typo_start = i;
-                    break;
-                }
-
-                ++typo_len;
-            }
-
-            // when detecting 'typo:', reduce the length of the string by one
-            if (space_last) {
-                --typo_len;
-            }
+        ++typo_len;
+    }
 
-            // convert buffer of keycodes into a string
-            for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
-            }
+    // when detecting 'typo:', reduce the length of the string by one
+    if (space_last) {
+        --typo_len;
+    }
 
-            /* Gather the corrected word
-             *
-             * A) Correction of 'typo:' -- Code takes into account
-             * an extra backspace to delete the space (which we dont copy)
-             * for this reason the offset is correct to "skip" the null terminator
-             *
-             * B) When correcting 'typo' -- Need extra offset for terminator
-             */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
-
-            uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
-
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P(changes);
-            }
+    // convert buffer of keycodes into a string
+    for (uint8_t i = 0; i < typo_len; ++i) {
+        typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+    }
 
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
-            }
+    /* Gather the corrected word
+     *
+     * A) Correction of 'typo:' -- Code takes into account
+     * an extra backspace to delete the space (which we dont copy)
+     * for this reason the offset is correct to "skip" the null terminator
+     *
+     * B) When correcting 'typo' -- Need extra offset for terminator
+     */
+    char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
+
+    uint8_t offset = space_last ? backspaces : backspaces + 1;
+    strcpy(correct, typo);
+    strcpy_P(correct + typo_len - offset, changes);
+
+    if (apply_autocorrect(backspaces, changes, typo, correct)) {
+        for (uint8_t i = 0; i < backspaces; ++i) {
+            tap_code(KC_BSPC);
         }
+        send_string_P(changes);
+    }
+
+#ifdef AUTOCORRECT_AUTOMATON
+    typo_states_size = 0;
+#endif
+    if (keycode == KC_SPC) {
+        typo_buffer[0]   = KC_SPC;
+        typo_buffer_size = 1;
+        return true;
+    } else {
+        typo_buffer_size = 0;
+        return false;
     }
-    return true;
 }
@@ -16,15 +16,18 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
+#include "debug.h"
 #include "wait.h"
 #include "keyboard.h"
 #include "keymap_common.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "action_util.h"
+#include "bitwise.h"
 #include "keymap_introspection.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
@@ -77,16 +80,35 @@ static uint16_t timer = 0;
 static bool     b_combo_enable = true; // defaults to enabled
 static uint16_t longest_term   = 0;
 
+/* Queued records are presses straight from action_exec(), so their tap state
+ * and record keycode are still empty and only the event is kept. */
 typedef struct {
-    keyrecord_t record;
-    uint16_t    combo_index;
-    uint16_t    keycode;
+    keypos_t key;
+    uint16_t time;
+    union {
+        uint16_t keycode;     // keycode matched against combos
+        uint16_t combo_index; // combo to fire, once type is COMBO_EVENT
+    };
+    uint8_t type;
 } queued_record_t;
 static uint8_t         key_buffer_size = 0;
 static queued_record_t key_buffer[COMBO_KEY_BUFFER_LENGTH];
 
+/* Bitset of key_buffer slots */
+#if COMBO_KEY_BUFFER_LENGTH > 32
+#    error "COMBO_KEY_BUFFER_LENGTH must be 32 or less"
+#elif COMBO_KEY_BUFFER_LENGTH > 16
+typedef uint32_t key_buffer_mask_t;
+#elif COMBO_KEY_BUFFER_LENGTH > 8
+typedef uint16_t key_buffer_mask_t;
+#else
+typedef uint8_t key_buffer_mask_t;
+#endif
+#define KEY_BUFFER_SLOT(slot) ((key_buffer_mask_t)1 << (slot))
+
 typedef struct {
-    uint16_t combo_index;
+    uint16_t          combo_index;
+    key_buffer_mask_t keys; // queued presses consumed by the combo, the last one completed it
 } queued_combo_t;
 static uint8_t        combo_buffer_write = 0;
 static uint8_t        combo_buffer_read  = 0;
@@ -94,6 +116,20 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+/* Maps each keycode to the combos containing it, sorted by keycode and then
+ * combo index so combos are still evaluated in the order they are defined. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_key_entry_t;
+static combo_key_entry_t combo_key_index[COMBO_KEY_INDEX_LENGTH];
+static uint16_t          combo_key_index_size  = 0;
+static uint16_t          combo_key_index_count = 0; // combo_count() the index was built for
+static bool              combo_key_index_built = false;
+static bool              combo_key_index_fits  = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -217,22 +253,35 @@ static inline void dump_key_buffer(void) {
         key_buffer_next = key_buffer_i + 1;
 
         queued_record_t *qrecord = &key_buffer[key_buffer_i];
-        keyrecord_t *    record  = &qrecord->record;
+        keyrecord_t      record  = {
+            .event =
+                {
+                    .key     = qrecord->key,
+                    .time    = qrecord->time,
+                    .type    = qrecord->type,
+                    .pressed = true,
+                },
+        };
 
-        if (IS_NOEVENT(record->event)) {
+        if (IS_NOEVENT(record.event)) {
             continue;
         }
 
-        if (!record->keycode && qrecord->combo_index != (uint16_t)-1) {
+        if (qrecord->type == COMBO_EVENT) {
+            record.keycode   = combo_get(qrecord->combo_index)->keycode;
+            record.event.key = MAKE_KEYPOS(0, 0);
+        }
+        qrecord->type = TICK_EVENT;
+
+        if (!record.keycode && record.event.type == COMBO_EVENT) {
             process_combo_event(qrecord->combo_index, true);
         } else {
 #ifndef NO_ACTION_TAPPING
-            action_tapping_process(*record);
+            action_tapping_process(record);
 #else
-            process_record(record);
+            process_record(&record);
 #endif
         }
-        record->event.type = TICK_EVENT;
 
 #if defined(CAPS_WORD_ENABLE) && defined(AUTO_SHIFT_ENABLE)
         // Edge case: preserve the weak Left Shift mod if both Caps Word and
@@ -246,7 +295,7 @@ static inline void dump_key_buffer(void) {
 
 #if TAP_CODE_DELAY > 0
         // only delay once and for a non-tapping key
-        if (!delay_done && !is_tap_record(record)) {
+        if (!delay_done && !is_tap_record(&record)) {
             delay_done = true;
             wait_ms(TAP_CODE_DELAY);
         }
@@ -256,7 +305,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -278,6 +326,64 @@ static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keyc
     }
 }
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+/* Position of the first entry for keycode, or where it would be */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_key_index_size;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (combo_key_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static bool combo_key_index_build(void) {
+    combo_key_index_size  = 0;
+    combo_key_index_count = combo_count();
+
+    for (uint16_t idx = 0; idx < combo_key_index_count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            /* Combos are added in order, so inserting after any equal keycodes keeps each list sorted by combo index */
+            uint16_t pos = combo_key_index_size;
+            while (pos > 0 && combo_key_index[pos - 1].keycode > key) {
+                pos--;
+            }
+            if (pos > 0 && combo_key_index[pos - 1].keycode == key && combo_key_index[pos - 1].combo_index == idx) {
+                // key listed twice in the same combo
+                continue;
+            }
+            if (combo_key_index_size >= COMBO_KEY_INDEX_LENGTH) {
+                dprintf("combo: more than COMBO_KEY_INDEX_LENGTH (%u) combo keys, not indexing\n", COMBO_KEY_INDEX_LENGTH);
+                return false;
+            }
+            memmove(&combo_key_index[pos + 1], &combo_key_index[pos], (combo_key_index_size - pos) * sizeof(combo_key_entry_t));
+            combo_key_index[pos] = (combo_key_entry_t){.keycode = key, .combo_index = idx};
+            combo_key_index_size++;
+        }
+    }
+    return true;
+}
+
+void combo_key_index_invalidate(void) {
+    combo_key_index_built = false;
+}
+
+/* Build the index on first use, or when the number of combos changes */
+static bool combo_key_index_ready(void) {
+    if (!combo_key_index_built || combo_key_index_count != combo_count()) {
+        combo_key_index_fits  = combo_key_index_build();
+        combo_key_index_built = true;
+    }
+    return combo_key_index_fits;
+}
+#endif
+
 void drop_combo_from_buffer(uint16_t combo_index) {
     /* Mark a combo as processed from the buffer. If the buffer is in the
      * beginning of the buffer, drop it.  */
@@ -298,6 +404,15 @@ void drop_combo_from_buffer(uint16_t combo_index) {
     }
 }
 
+static queued_combo_t *find_buffered_combo(uint16_t combo_index) {
+    for (uint8_t i = combo_buffer_read; i != combo_buffer_write; INCREMENT_MOD(i)) {
+        if (combo_buffer[i].combo_index == combo_index) {
+            return &combo_buffer[i];
+        }
+    }
+    return NULL;
+}
+
 void apply_combo(uint16_t combo_index, combo_t *combo) {
     /* Apply combo's result keycode to the last chord key of the combo and
      * disable the other keys. */
@@ -306,44 +421,25 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
         return;
     }
 
-    // state to check against so we find the last key of the combo from the buffer
-#if defined(EXTRA_EXTRA_LONG_COMBOS)
-    uint32_t state = 0;
-#elif defined(EXTRA_LONG_COMBOS)
-    uint16_t state         = 0;
-#else
-    uint8_t state = 0;
-#endif
-
-    for (uint8_t key_buffer_i = 0; key_buffer_i < key_buffer_size; key_buffer_i++) {
-        queued_record_t *qrecord = &key_buffer[key_buffer_i];
-        keyrecord_t *    record  = &qrecord->record;
-        uint16_t         keycode = qrecord->keycode;
-
-        uint8_t  key_count = 0;
-        uint16_t key_index = -1;
-        _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-        if (-1 == (int16_t)key_index) {
-            // key not part of this combo
-            continue;
-        }
-
-        KEY_STATE_DOWN(state, key_index);
-        if (ALL_COMBO_KEYS_ARE_DOWN(state, key_count)) {
-            // this in the end executes the combo when the key_buffer is dumped.
-            record->keycode    = combo->keycode;
-            record->event.type = COMBO_EVENT;
-            record->event.key  = MAKE_KEYPOS(0, 0);
-
-            qrecord->combo_index = combo_index;
-            ACTIVATE_COMBO(combo);
+    queued_combo_t *qcombo = find_buffered_combo(combo_index);
+    if (qcombo) {
+        for (uint8_t key_buffer_i = 0; key_buffer_i < key_buffer_size; key_buffer_i++) {
+            if (!(qcombo->keys & KEY_BUFFER_SLOT(key_buffer_i))) {
+                // key not part of this combo
+                continue;
+            }
 
-            break;
-        } else {
-            // key was part of the combo but not the last one, "disable" it
-            // by making it a TICK event.
-            record->event.type = TICK_EVENT;
+            queued_record_t *qrecord = &key_buffer[key_buffer_i];
+            if (!(qcombo->keys >> key_buffer_i >> 1)) {
+                // this in the end executes the combo when the key_buffer is dumped.
+                qrecord->type        = COMBO_EVENT;
+                qrecord->combo_index = combo_index;
+                ACTIVATE_COMBO(combo);
+            } else {
+                // key was part of the combo but not the last one, "disable" it
+                // by making it a TICK event.
+                qrecord->type = TICK_EVENT;
+            }
         }
     }
     drop_combo_from_buffer(combo_index);
@@ -368,27 +464,47 @@ static inline void apply_combos(void) {
     clear_combos();
 }
 
-combo_t *overlaps(combo_t *combo1, combo_t *combo2) {
-    /* Checks if the combos overlap and returns the combo that should be
-     * dropped from the combo buffer.
-     * The combo that has less keys will be dropped. If they have the same
-     * amount of keys, drop combo1. */
+/* Find the queued presses consumed by the combo, counting keycode as the
+ * press about to be queued. Each combo key is taken by its first press, and
+ * the combo is completed by the last of those. Returns 0 if some key was not
+ * queued, or the completing press doesn't fit in the key buffer. */
+static key_buffer_mask_t combo_key_presses(combo_t *combo, uint16_t keycode) {
+    if (key_buffer_size >= COMBO_KEY_BUFFER_LENGTH) {
+        return 0;
+    }
 
-    uint8_t  idx1 = 0, idx2 = 0;
-    uint16_t key1, key2;
-    bool     overlaps = false;
+    key_buffer_mask_t presses = 0;
+    key_buffer_mask_t last    = 0;
+    uint16_t          key;
+    for (uint8_t key_index = 0; (key = pgm_read_word(&combo->keys[key_index])) != COMBO_END; ++key_index) {
+        key_buffer_mask_t matches = key == keycode ? KEY_BUFFER_SLOT(key_buffer_size) : 0;
+        for (uint8_t key_buffer_i = 0; key_buffer_i < key_buffer_size; key_buffer_i++) {
+            if (key_buffer[key_buffer_i].keycode == key) {
+                matches |= KEY_BUFFER_SLOT(key_buffer_i);
+            }
+        }
+        if (!matches) {
+            return 0;
+        }
 
-    while ((key1 = pgm_read_word(&combo1->keys[idx1])) != COMBO_END) {
-        idx2 = 0;
-        while ((key2 = pgm_read_word(&combo2->keys[idx2])) != COMBO_END) {
-            if (key1 == key2) overlaps = true;
-            idx2 += 1;
+        presses |= matches;
+        matches &= -matches; // first press of the key
+        if (last < matches) {
+            last = matches;
         }
-        idx1 += 1;
     }
 
-    if (!overlaps) return NULL;
-    if (idx2 < idx1) return combo2;
+    // presses after the completing one are left alone
+    return presses & (key_buffer_mask_t)((last << 1) - 1);
+}
+
+/* Checks if the combos share a key press and returns the combo that should
+ * be dropped from the combo buffer.
+ * The combo that consumes less presses will be dropped. If they consume the
+ * same amount, drop combo1. */
+static inline const queued_combo_t *overlaps(const queued_combo_t *combo1, const queued_combo_t *combo2) {
+    if (!(combo1->keys & combo2->keys)) return NULL;
+    if (bitpop32(combo2->keys) < bitpop32(combo1->keys)) return combo2;
     return combo1;
 }
 
@@ -454,18 +570,22 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 #endif
             {
 
+                queued_combo_t current = {
+                    .combo_index = combo_index,
+                    .keys        = combo_key_presses(combo, keycode),
+                };
+
                 // disable readied combos that overlap with this combo
-                combo_t *drop = NULL;
+                const queued_combo_t *drop = NULL;
                 for (uint8_t combo_buffer_i = combo_buffer_read; combo_buffer_i != combo_buffer_write; INCREMENT_MOD(combo_buffer_i)) {
-                    queued_combo_t *qcombo         = &combo_buffer[combo_buffer_i];
-                    combo_t *       buffered_combo = combo_get(qcombo->combo_index);
+                    queued_combo_t *qcombo = &combo_buffer[combo_buffer_i];
 
-                    if ((drop = overlaps(buffered_combo, combo))) {
-                        DISABLE_COMBO(drop);
-                        if (drop == combo) {
+                    if ((drop = overlaps(qcombo, &current))) {
+                        DISABLE_COMBO(combo_get(drop->combo_index));
+                        if (drop == &current) {
                             // stop checking for overlaps if dropped combo was current combo.
                             break;
-                        } else if (combo_buffer_i == combo_buffer_read && drop == buffered_combo) {
+                        } else if (combo_buffer_i == combo_buffer_read) {
                             /* Drop the disabled buffered combo from the buffer if
                              * it is in the beginning of the buffer. */
                             INCREMENT_MOD(combo_buffer_read);
@@ -473,11 +593,9 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
                     }
                 }
 
-                if (drop != combo) {
+                if (drop != &current && current.keys) {
                     // save this combo to buffer
-                    combo_buffer[combo_buffer_write] = (queued_combo_t){
-                        .combo_index = combo_index,
-                    };
+                    combo_buffer[combo_buffer_write] = current;
                     INCREMENT_MOD(combo_buffer_write);
 
                     // get possible longer waiting time for tap-/hold-only combos.
@@ -534,9 +652,29 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_combos_for_key(uint16_t keycode, keyrecord_t *record) {
+    bool is_combo_key = false;
+
+#ifdef COMBO_KEY_INDEX_LENGTH
+    if (combo_key_index_ready()) {
+        // only the combos containing this keycode can change state
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_size && combo_key_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_key_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+        return is_combo_key;
+    }
+#endif
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        combo_t *combo = combo_get(idx);
+        is_combo_key |= process_single_combo(combo, keycode, record, idx);
+    }
+    return is_combo_key;
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,11 +702,7 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
-    }
+    is_combo_key = process_combos_for_key(keycode, record);
 
     if (record->event.pressed && is_combo_key) {
 #ifndef COMBO_NO_TIMER
@@ -584,9 +718,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 
         if (key_buffer_size < COMBO_KEY_BUFFER_LENGTH) {
             key_buffer[key_buffer_size++] = (queued_record_t){
-                .record      = *record,
-                .keycode     = keycode,
-                .combo_index = -1, // this will be set when applying combos
+                .key     = record->event.key,
+                .time    = record->event.time,
+                .keycode = keycode,
+                .type    = record->event.type,
             };
         }
     } else {
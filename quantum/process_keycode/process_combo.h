@@ -77,6 +77,11 @@ bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+/* Rebuild the keycode to combo index on next use, for when combo_get() returns changed keys */
+void combo_key_index_invalidate(void);
+#endif
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
@@ -18,11 +18,22 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
+#include "quantum_keycodes.h"
 #include "debug.h"
+#include "timer.h"
+#include "util.h"
 #include "wait.h"
 
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#    include "send_string_keycodes.h"
+#elif defined(DYNAMIC_MACRO_PERSIST)
+#    error "DYNAMIC_MACRO_PERSIST requires DYNAMIC_KEYMAP_ENABLE"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -58,165 +69,537 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+/* Both macros share one byte buffer but are written from opposite
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ *  macro_buffer      macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^
+ *                    macro_length[1]
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * Each recorded event is packed as:
+ *
+ *   header   bit 0: pressed, bit 1: a tap state byte follows
+ *   delay    varint, milliseconds since the previous event
+ *   keycode  varint
+ *   tap      the tap_t of the event, if flagged in the header
+ *
+ * Varints hold 7 bits per byte, least significant first, with bit 7
+ * set on all but the last byte. Most events take 3 or 4 bytes.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+#define DYNAMIC_MACRO_EVENT_PRESSED 0x01
+#define DYNAMIC_MACRO_EVENT_TAP 0x02
+#define DYNAMIC_MACRO_EVENT_MAX_SIZE 8
+
+/* Keys a playing macro can hold down at once. Further presses are still
+ * played but not released for the macro when it ends. */
+#define DYNAMIC_MACRO_HELD_KEYS 8
+
+#define DYNAMIC_MACRO_DIRECTION(slot) ((slot) == 1 ? +1 : -1)
+
+typedef struct {
+    uint16_t keycode;
+    uint16_t delay;
+    bool     pressed;
+    uint8_t  tap;
+} dynamic_macro_event_t;
+
+static uint8_t macro_buffer[DYNAMIC_MACRO_BYTES];
+
+/* Bytes used by each macro. */
+static uint16_t macro_length[2] = {0, 0};
+
+/* Time of the last event recorded, the next one is stored relative to it. */
+static uint32_t macro_last_time = 0;
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+/* Playback state. A macro may play the other one, so there can be
+ * two macros in flight with the outer one waiting on the inner.
+ *
+ * The user can keep typing while a macro plays, so playback leaves the
+ * live keyboard state alone. Each macro only keeps track of what it
+ * changed itself: the keys it is holding down and the layers it has
+ * switched. When it ends, those keys are released and those layers are
+ * switched back, and anything the user holds is left as it is.
+ */
+static struct {
+    struct {
+        uint8_t       slot;
+        uint16_t      offset; // Next event to play
+        uint8_t       held_count;
+        uint16_t      held[DYNAMIC_MACRO_HELD_KEYS]; // Keycodes pressed by the macro and not yet released
+        layer_state_t layers;                        // Layers switched by the macro, switched back once it is done
+    } frames[2];
+    uint8_t  depth;
+    keypos_t key;       // Position of the play key, replayed events appear to come from it
+    uint32_t last_time; // When the last event was played
+} macro_player;
+
+static inline uint8_t *dynamic_macro_byte(uint8_t slot, uint16_t offset) {
+    return slot == 1 ? &macro_buffer[offset] : &macro_buffer[DYNAMIC_MACRO_BYTES - 1 - offset];
+}
+
+static uint8_t dynamic_macro_put_varint(uint8_t *data, uint16_t value) {
+    uint8_t size = 0;
+    while (value >= 0x80) {
+        data[size++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    data[size++] = value;
+    return size;
+}
+
+static uint16_t dynamic_macro_get_varint(uint8_t slot, uint16_t *offset) {
+    uint16_t value = 0;
+    for (uint8_t shift = 0;; shift += 7) {
+        uint8_t data = *dynamic_macro_byte(slot, (*offset)++);
+        value |= (uint16_t)(data & 0x7F) << shift;
+        if (!(data & 0x80)) {
+            return value;
+        }
+    }
+}
+
+/**
+ * Pack an event.
+ *
+ * @param data[out] At least DYNAMIC_MACRO_EVENT_MAX_SIZE bytes.
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *data, const dynamic_macro_event_t *event) {
+    uint8_t size = 0;
+    data[size++] = (event->pressed ? DYNAMIC_MACRO_EVENT_PRESSED : 0) | (event->tap ? DYNAMIC_MACRO_EVENT_TAP : 0);
+    size += dynamic_macro_put_varint(&data[size], event->delay);
+    size += dynamic_macro_put_varint(&data[size], event->keycode);
+    if (event->tap) {
+        data[size++] = event->tap;
+    }
+    return size;
+}
+
+/**
+ * Unpack the event of a macro at the given offset.
+ *
+ * @return The offset of the following event.
+ */
+static uint16_t dynamic_macro_decode(uint8_t slot, uint16_t offset, dynamic_macro_event_t *event) {
+    uint8_t header = *dynamic_macro_byte(slot, offset++);
+    event->pressed = header & DYNAMIC_MACRO_EVENT_PRESSED;
+    event->delay   = dynamic_macro_get_varint(slot, &offset);
+    event->keycode = dynamic_macro_get_varint(slot, &offset);
+    event->tap     = (header & DYNAMIC_MACRO_EVENT_TAP) ? *dynamic_macro_byte(slot, offset++) : 0;
+    return offset;
+}
+
+/**
+ * Play one event of a macro, keeping track of the keys it holds and
+ * the layers it switches.
+ */
+static void dynamic_macro_play_event(uint8_t frame, const dynamic_macro_event_t *event) {
+    uint8_t  *count = &macro_player.frames[frame].held_count;
+    uint16_t *held  = macro_player.frames[frame].held;
+
+    if (event->pressed) {
+        if (*count < DYNAMIC_MACRO_HELD_KEYS) {
+            held[(*count)++] = event->keycode;
+        } else {
+            dprintf("dynamic macro: too many keys held, 0x%04X stays pressed\n", event->keycode);
+        }
+    } else {
+        for (uint8_t i = 0; i < *count; i++) {
+            if (held[i] == event->keycode) {
+                held[i] = held[--(*count)];
+                break;
+            }
+        }
+    }
+
+    keyrecord_t record = {
+        .event =
+            {
+                .key     = macro_player.key,
+                .time    = timer_read(),
+                .type    = KEY_EVENT,
+                .pressed = event->pressed,
+            },
+        .keycode = event->keycode,
+    };
+#ifndef NO_ACTION_TAPPING
+    memcpy(&record.tap, &event->tap, sizeof(record.tap));
+#endif
+
+    layer_state_t before = layer_state;
+    process_record(&record);
+    macro_player.frames[frame].layers ^= before ^ layer_state;
+}
+
+/**
+ * Undo what a macro left behind: release the keys it still holds and
+ * switch back the layers it switched.
+ */
+static void dynamic_macro_play_release(uint8_t frame) {
+    while (macro_player.frames[frame].held_count > 0) {
+        dynamic_macro_event_t event = {
+            .keycode = macro_player.frames[frame].held[macro_player.frames[frame].held_count - 1],
+            .pressed = false,
+        };
+        dynamic_macro_play_event(frame, &event);
+    }
+    if (macro_player.frames[frame].layers) {
+        layer_state_set(layer_state ^ macro_player.frames[frame].layers);
+    }
+}
+
+/**
+ * Stop any playback in progress, without replaying the rest.
+ */
+static void dynamic_macro_play_cancel(void) {
+    if (macro_player.depth > 0) {
+        dprintln("dynamic macro: playback cancelled");
+        while (macro_player.depth > 0) {
+            dynamic_macro_play_release(--macro_player.depth);
+        }
+    }
+}
 
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param slot[in] The macro to record, 1 or 2.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(uint8_t slot) {
     dprintln("dynamic macro recording: started");
 
-    dynamic_macro_record_start_user(direction);
+    dynamic_macro_record_start_user(DYNAMIC_MACRO_DIRECTION(slot));
 
+    dynamic_macro_play_cancel();
     clear_keyboard();
     layer_clear();
-    *macro_pointer = macro_buffer;
+    macro_length[slot - 1] = 0;
+    macro_id               = slot;
 }
 
 /**
- * Play the dynamic macro.
+ * Play the dynamic macro. The events are replayed from
+ * dynamic_macro_task() with the timing they were recorded with.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param slot[in]   The macro to play, 1 or 2.
+ * @param record[in] The event that started the playback.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
-
-    layer_state_t saved_layer_state = layer_state;
+void dynamic_macro_play(uint8_t slot, keyrecord_t *record) {
+    for (uint8_t i = 0; i < macro_player.depth; i++) {
+        if (macro_player.frames[i].slot == slot) {
+            dprintf("dynamic macro: slot %d is already playing, ignoring\n", slot);
+            return;
+        }
+    }
 
-    clear_keyboard();
-    layer_clear();
+    dprintf("dynamic macro: slot %d playback\n", slot);
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
+    if (macro_player.depth == 0) {
+        macro_player.key       = record->event.key;
+        macro_player.last_time = timer_read32();
     }
+    macro_player.frames[macro_player.depth].slot       = slot;
+    macro_player.frames[macro_player.depth].offset     = 0;
+    macro_player.frames[macro_player.depth].held_count = 0;
+    macro_player.frames[macro_player.depth].layers     = 0;
+    macro_player.depth++;
+}
 
-    clear_keyboard();
+/**
+ * Finish playing the innermost macro.
+ */
+static void dynamic_macro_play_end(void) {
+    macro_player.depth--;
+
+    dynamic_macro_play_release(macro_player.depth);
+
+    dynamic_macro_play_user(DYNAMIC_MACRO_DIRECTION(macro_player.frames[macro_player.depth].slot));
+}
+
+bool dynamic_macro_is_playing(void) {
+    return macro_player.depth > 0;
+}
+
+void dynamic_macro_task(void) {
+    while (macro_player.depth > 0) {
+        uint8_t  frame  = macro_player.depth - 1;
+        uint8_t  slot   = macro_player.frames[frame].slot;
+        uint16_t offset = macro_player.frames[frame].offset;
 
-    layer_state_set(saved_layer_state);
+        if (offset >= macro_length[slot - 1]) {
+            dynamic_macro_play_end();
+            continue;
+        }
 
-    dynamic_macro_play_user(direction);
+        dynamic_macro_event_t event;
+        uint16_t              next = dynamic_macro_decode(slot, offset, &event);
+#ifdef DYNAMIC_MACRO_DELAY
+        uint32_t due = macro_player.last_time + (offset == 0 ? 0 : DYNAMIC_MACRO_DELAY);
+#else
+        uint32_t due = macro_player.last_time + event.delay;
+#endif
+        if (!timer_expired32(timer_read32(), due)) {
+            return;
+        }
+        macro_player.frames[frame].offset = next;
+        // Keep to the recorded timing even if this event is late
+        macro_player.last_time = due;
+
+        dynamic_macro_play_event(frame, &event);
+    }
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param slot[in]    The macro being recorded, 1 or 2.
+ * @param keycode[in] The keycode of the current keypress.
+ * @param record[in]  The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(uint8_t slot, uint16_t keycode, keyrecord_t *record) {
+    uint16_t *length = &macro_length[slot - 1];
+
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && *length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
-     */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    /* There is nothing to replay for keys without a keycode. */
+    if (keycode == KC_NO) {
+        return;
+    }
+
+    /* Widen the event time, so pauses longer than the 16 bit timer wraps
+     * around in are still measured, then saturated to what is stored. */
+    uint32_t time  = timer_read32() - TIMER_DIFF_16(timer_read(), record->event.time);
+    uint32_t delay = *length == 0 ? 0 : TIMER_DIFF_32(time, macro_last_time);
+
+    dynamic_macro_event_t event = {
+        .keycode = keycode,
+        .delay   = MIN(delay, UINT16_MAX),
+        .pressed = record->event.pressed,
+    };
+#ifndef NO_ACTION_TAPPING
+    memcpy(&event.tap, &record->tap, sizeof(record->tap));
+#endif
+
+    uint8_t data[DYNAMIC_MACRO_EVENT_MAX_SIZE];
+    uint8_t size = dynamic_macro_encode(data, &event);
+
+    /* The start of the other macro is as far as it is safe to go. */
+    uint16_t capacity = DYNAMIC_MACRO_BYTES - macro_length[2 - slot];
+    if (*length + size <= capacity) {
+        for (uint8_t i = 0; i < size; i++) {
+            *dynamic_macro_byte(slot, *length + i) = data[i];
+        }
+        *length += size;
+        macro_last_time = time;
     } else {
-        dynamic_macro_record_key_user(direction, record);
+        dynamic_macro_record_key_user(DYNAMIC_MACRO_DIRECTION(slot), record);
     }
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", slot, *length, capacity);
 }
 
 /**
- * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * End recording of the dynamic macro.
+ *
+ * @param slot[in] The macro being recorded, 1 or 2.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
-    dynamic_macro_record_end_user(direction);
+void dynamic_macro_record_end(uint8_t slot) {
+    dynamic_macro_record_end_user(DYNAMIC_MACRO_DIRECTION(slot));
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    uint16_t length = 0;
+    for (uint16_t offset = 0; offset < macro_length[slot - 1];) {
+        dynamic_macro_event_t event;
+        offset = dynamic_macro_decode(slot, offset, &event);
+        if (!event.pressed) {
+            length = offset;
+        }
+    }
+    if (length != macro_length[slot - 1]) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+        macro_length[slot - 1] = length;
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", slot, length);
 
-    *macro_end = macro_pointer;
+#ifdef DYNAMIC_MACRO_PERSIST
+    dynamic_macro_persist(slot, DYNAMIC_MACRO_PERSIST + slot - 1);
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
+#ifdef DYNAMIC_KEYMAP_ENABLE
+static void dynamic_macro_persist_put(uint16_t *offset, uint8_t data, bool write) {
+    if (write) {
+        dynamic_keymap_macro_set_buffer(*offset, 1, &data);
+    }
+    (*offset)++;
+}
+
+static void dynamic_macro_persist_delay(uint16_t *offset, uint32_t delay, bool write) {
+    while (delay > 0) {
+        // The player reads at most 4 digits
+        uint16_t ms = MIN(delay, 9999U);
+        char     digits[5];
+        uint8_t  count = 0;
+        delay -= ms;
+        do {
+            digits[count++] = '0' + ms % 10;
+            ms /= 10;
+        } while (ms > 0);
+        dynamic_macro_persist_put(offset, SS_QMK_PREFIX, write);
+        dynamic_macro_persist_put(offset, SS_DELAY_CODE, write);
+        while (count > 0) {
+            dynamic_macro_persist_put(offset, digits[--count], write);
+        }
+        dynamic_macro_persist_put(offset, '|', write);
+    }
+}
+
+/**
+ * Write a macro as a send_string sequence, including its terminator.
+ * Keys that have no basic keycode to send are left out.
  *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
+ * @return The offset after the terminator.
+ */
+static uint16_t dynamic_macro_persist_encode(uint8_t slot, uint16_t offset, bool write) {
+    uint32_t delay = 0;
+    for (uint16_t i = 0; i < macro_length[slot - 1];) {
+        dynamic_macro_event_t event;
+        i = dynamic_macro_decode(slot, i, &event);
+        delay += event.delay;
+
+        uint16_t keycode = event.keycode;
+#    ifndef NO_ACTION_TAPPING
+        tap_t tap;
+        memcpy(&tap, &event.tap, sizeof(tap));
+        if (tap.count > 0 && IS_QK_MOD_TAP(keycode)) {
+            keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+        } else if (tap.count > 0 && IS_QK_LAYER_TAP(keycode)) {
+            keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+        }
+#    endif
+        if (!IS_QK_BASIC(keycode)) {
+            dprintf("dynamic macro: keycode 0x%04X cannot be persisted, skipping\n", event.keycode);
+            continue;
+        }
+
+        dynamic_macro_persist_delay(&offset, delay, write);
+        delay = 0;
+        dynamic_macro_persist_put(&offset, SS_QMK_PREFIX, write);
+        dynamic_macro_persist_put(&offset, event.pressed ? SS_DOWN_CODE : SS_UP_CODE, write);
+        dynamic_macro_persist_put(&offset, keycode, write);
+    }
+    dynamic_macro_persist_put(&offset, 0, write);
+    return offset;
+}
+
+/**
+ * Move part of the dynamic keymap macro buffer, which may overlap its
+ * destination.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+static void dynamic_macro_persist_move(uint16_t from, uint16_t to, uint16_t size) {
+    uint8_t chunk[16];
+    while (size > 0) {
+        uint16_t count = MIN(size, sizeof(chunk));
+        // Copy from the end when moving up so nothing is overwritten before it is read
+        uint16_t skip = to > from ? size - count : 0;
+        dynamic_keymap_macro_get_buffer(from + skip, count, chunk);
+        dynamic_keymap_macro_set_buffer(to + skip, count, chunk);
+        size -= count;
+        if (to < from) {
+            from += count;
+            to += count;
+        }
+    }
+}
 
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+bool dynamic_macro_persist(uint8_t slot, uint8_t id) {
+    if (slot < 1 || slot > 2 || id >= dynamic_keymap_macro_get_count()) {
+        return false;
+    }
 
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    // Find the macro being replaced, and the end of the last macro
+    uint16_t size  = dynamic_keymap_macro_get_buffer_size();
+    uint16_t start = 0, end = 0, used = 0;
+    uint8_t  index = 0;
+    for (uint16_t offset = 0; offset < size && index < dynamic_keymap_macro_get_count(); offset++) {
+        uint8_t data;
+        dynamic_keymap_macro_get_buffer(offset, 1, &data);
+        if (data == 0) {
+            if (index++ == id) {
+                start = used;
+                end   = offset + 1;
+            }
+            used = offset + 1;
+        }
+    }
+    if (end == 0) {
+        dprintf("dynamic macro: macro %d not found in the macro buffer\n", id);
+        return false;
+    }
 
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    uint16_t length   = dynamic_macro_persist_encode(slot, 0, false);
+    uint16_t new_used = used - (end - start) + length;
+    if (new_used > size) {
+        dprintf("dynamic macro: slot %d does not fit in macro %d\n", slot, id);
+        return false;
+    }
 
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+    // Mark the buffer as being written, see dynamic_keymap.h
+    uint8_t data = 0xFF;
+    dynamic_keymap_macro_set_buffer(size - 1, 1, &data);
 
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
+    // Make room, leaving out the terminator of the last macro which might be the last byte of the buffer
+    if (used > end + 1) {
+        dynamic_macro_persist_move(end, start + length, used - end - 1);
+    }
+    dynamic_macro_persist_encode(slot, start, true);
+    data = 0;
+    for (uint16_t offset = new_used - 1; offset < MAX(used, new_used); offset++) {
+        if (offset < size - 1) {
+            dynamic_keymap_macro_set_buffer(offset, 1, &data);
+        }
+    }
+    dynamic_keymap_macro_set_buffer(size - 1, 1, &data);
+
+    dprintf("dynamic macro: slot %d persisted to macro %d, %d bytes\n", slot, id, length);
+    return true;
+}
+#endif
 
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
 void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+    if (macro_id != 0) {
+        dynamic_macro_record_end(macro_id);
     }
     macro_id = 0;
 }
@@ -237,18 +620,16 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
-                    macro_id = 1;
+                    dynamic_macro_record_start(1);
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
-                    macro_id = 2;
+                    dynamic_macro_record_start(2);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(1, record);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(2, record);
                     return false;
             }
         }
@@ -274,14 +655,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_user(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(macro_id, keycode, record);
                 }
                 return true;
                 break;
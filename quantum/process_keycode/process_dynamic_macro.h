@@ -22,8 +22,9 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
+/* May be overridden with a custom value. This used to be the number
+ * of events the buffer could hold, and the buffer keeps the size it
+ * had then, see dynamic_macro_record_size_t below. Be aware that each keypress is recorded twice
  * because of the down-event and up-event. This is not a bug, it's the
  * intended behavior.
  *
@@ -35,6 +36,23 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* The event the buffer used to hold, which is keyrecord_t without the
+ * keycode field it has since gained. Only used for its size.
+ */
+typedef struct {
+    keyevent_t event;
+#ifndef NO_ACTION_TAPPING
+    tap_t tap;
+#endif
+} dynamic_macro_record_size_t;
+
+/* Size of the buffer shared by both macros, in bytes. Events are packed
+ * and most take 3 or 4 bytes.
+ */
+#ifndef DYNAMIC_MACRO_BYTES
+#    define DYNAMIC_MACRO_BYTES (DYNAMIC_MACRO_SIZE * sizeof(dynamic_macro_record_size_t))
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_record_start_user(int8_t direction);
@@ -42,3 +60,13 @@ void dynamic_macro_play_user(int8_t direction);
 void dynamic_macro_record_key_user(int8_t direction, keyrecord_t *record);
 void dynamic_macro_record_end_user(int8_t direction);
 void dynamic_macro_stop_recording(void);
+bool dynamic_macro_is_playing(void);
+void dynamic_macro_task(void);
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+/* Copies a recorded macro, 1 or 2, into the dynamic keymap macro id,
+ * so it outlives a power cycle. Only basic keycodes can be stored,
+ * other keys are left out.
+ */
+bool dynamic_macro_persist(uint8_t slot, uint8_t id);
+#endif
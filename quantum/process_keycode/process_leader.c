@@ -39,6 +39,10 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
             leader_reset_timer();
 #endif
 
+            if (leader_sequence_resolved()) {
+                leader_end();
+            }
+
             return false;
         } else if (keycode == QK_LEADER) {
             leader_start();
@@ -132,6 +132,7 @@ __attribute__((weak)) void unregister_code16(uint16_t code) {
  */
 __attribute__((weak)) void tap_code16_delay(uint16_t code, uint16_t delay) {
     register_code16(code);
+    keyboard_report_batch_flush();
     for (uint16_t i = delay; i > 0; i--) {
         wait_ms(1);
     }
@@ -174,6 +175,7 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+    eeprom_sync();
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -208,7 +210,7 @@ void soft_reset_keyboard(void) {
 
 /* Convert record into usable keycode via the contained event. */
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
-#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE) || defined(DYNAMIC_MACRO_ENABLE)
     if (record->keycode) {
         return record->keycode;
     }
@@ -256,140 +258,197 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
 #endif
 
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
 
-#ifdef RGBLIGHT_ENABLE
-    if (record->event.pressed) {
-        preprocess_rgblight();
-    }
-#endif
+#ifdef PROCESS_RECORD_PROFILE
+__attribute__((weak)) void process_record_profile_begin(const char *handler) {}
+__attribute__((weak)) void process_record_profile_end(const char *handler, bool result) {}
 
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
+#    define PROCESS_RECORD_HANDLER(handler, first_keycode, last_keycode) \
+        { .process = (handler), .first = (first_keycode), .last = (last_keycode), .name = #handler }
+#else
+#    define PROCESS_RECORD_HANDLER(handler, first_keycode, last_keycode) \
+        { .process = (handler), .first = (first_keycode), .last = (last_keycode) }
 #endif
+// For handlers that need to see every key event, e.g. to record or track other keys
+#define PROCESS_RECORD_ALL(handler) PROCESS_RECORD_HANDLER(handler, 0x0000, 0xFFFF)
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
+typedef struct {
+    bool (*process)(uint16_t keycode, keyrecord_t *record);
+    uint16_t first; // Keycode range the handler acts on, it is skipped for anything else
+    uint16_t last;
+#ifdef PROCESS_RECORD_PROFILE
+    const char *name;
 #endif
+} process_record_handler_t;
+
+/* The process_* handlers of the enabled features, in the order they run.
+ * Any of them can return false to halt all further processing. */
+static const process_record_handler_t process_record_handlers[] = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_ALL(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_RECORD_ALL(process_last_key),
+    PROCESS_RECORD_ALL(process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_RECORD_ALL(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_RECORD_ALL(process_haptic),
 #endif
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_record_via, QK_MACRO, QK_MACRO_MAX),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_mouse),
 #endif
-            process_record_kb(keycode, record) &&
+    PROCESS_RECORD_ALL(process_record_kb),
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_RECORD_ALL(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_sequencer, QK_SEQUENCER, QK_SEQUENCER_MAX),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_midi, QK_MIDI, QK_MIDI_MAX),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_audio, QK_AUDIO, QK_AUDIO_MAX),
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_backlight, QK_LIGHTING, QK_LIGHTING_MAX),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_steno, QK_STENO, QK_STENO_MAX),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_RECORD_ALL(process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_RECORD_ALL(process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_RECORD_ALL(process_key_override_handler),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_tap_dance, QK_TAP_DANCE, QK_TAP_DANCE_MAX),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+    PROCESS_RECORD_ALL(process_unicode_common),
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_RECORD_ALL(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_dynamic_tapping_term, QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_RECORD_ALL(process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_magic, QK_MAGIC, QK_MAGIC_MAX),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_grave_esc, QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_rgb_handler, QK_LIGHTING, QK_LIGHTING_MAX),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_joystick, QK_JOYSTICK, QK_JOYSTICK_MAX),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_programmable_button, QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_RECORD_ALL(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_tri_layer, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER),
+#endif
+};
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
 #endif
-            true)) {
+
+#ifdef RGBLIGHT_ENABLE
+    if (record->event.pressed) {
+        preprocess_rgblight();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
         return false;
     }
+#endif
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_handlers); i++) {
+        const process_record_handler_t *handler = &process_record_handlers[i];
+        if (keycode < handler->first || keycode > handler->last) {
+            continue;
+        }
+#ifdef PROCESS_RECORD_PROFILE
+        process_record_profile_begin(handler->name);
+        bool result = handler->process(keycode, record);
+        process_record_profile_end(handler->name, result);
+        if (!result) {
+            return false;
+        }
+#else
+        if (!handler->process(keycode, record)) {
+            return false;
+        }
+#endif
+    }
 
     if (record->event.pressed) {
         switch (keycode) {
@@ -179,6 +179,10 @@ extern layer_state_t layer_state;
 #    include "secure.h"
 #endif
 
+#ifdef BOOT_PROFILE_ENABLE
+#    include "boot_profile.h"
+#endif
+
 #ifdef DYNAMIC_KEYMAP_ENABLE
 #    include "dynamic_keymap.h"
 #endif
@@ -252,6 +256,12 @@ bool     process_record_user(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_kb(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_user(uint16_t keycode, keyrecord_t *record);
 
+#ifdef PROCESS_RECORD_PROFILE
+/* Called around each process_* handler that process_record_quantum() runs, e.g. to sample a cycle counter */
+void process_record_profile_begin(const char *handler);
+void process_record_profile_end(const char *handler, bool result);
+#endif
+
 void reset_keyboard(void);
 void soft_reset_keyboard(void);
 
@@ -13,7 +13,9 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
         uint16_t tick = max_tick;
         // Reverse search to find most recent key hit
         for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
-            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
+            // Hits are ordered oldest first, nothing older can be more recent than max_tick
+            if (g_last_hit_tracker.tick[j] >= tick) break;
+            if (g_last_hit_tracker.index[j] == i) {
                 tick = g_last_hit_tracker.tick[j];
                 break;
             }
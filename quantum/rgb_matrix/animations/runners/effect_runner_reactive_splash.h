@@ -4,10 +4,24 @@
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Runs effect_func for every hit from start onwards, skipping hits whose scaled tick has reached
+// horizon: the tick after which the effect no longer lights any LED, whatever its distance. Only
+// effects whose faded hits leave the hue alone as well can use it, the output must not change
+bool effect_runner_reactive_splash_horizon(uint8_t start, uint16_t horizon, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+#    ifdef RGB_MATRIX_REACTIVE_SPLASH_NO_HORIZON
+    // Reference output for the unit tests, which check the horizon against it
+    horizon = UINT16_MAX;
+#    endif
+
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t ticks[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        ticks[j] = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        // Hits are ordered oldest first, so the faded out ones form a prefix
+        if (ticks[j] >= horizon) start = j + 1;
+    }
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
@@ -16,8 +30,7 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
             int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
             int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
             uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+            hsv           = effect_func(hsv, dx, dy, dist, ticks[j]);
         }
         hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
         RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -26,4 +39,8 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_horizon(start, UINT16_MAX, params, effect_func);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
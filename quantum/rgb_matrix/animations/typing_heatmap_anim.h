@@ -16,11 +16,127 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+#        ifdef RGB_MATRIX_TYPING_HEATMAP_LAZY_DECAY
+#            ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS_MAX
+#                define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS_MAX (RGB_MATRIX_LED_COUNT * 20)
+#            endif
+
+// Heat of each led as it was at the time of its stamp, decay is applied when it is read
+static uint8_t  heatmap_heat[RGB_MATRIX_LED_COUNT];
+static uint16_t heatmap_stamp[RGB_MATRIX_LED_COUNT];
+
+#            ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+typedef struct PACKED {
+    uint8_t led;
+    uint8_t amount;
+} heatmap_neighbour_t;
+
+// Leds within reach of each led, the ones of led i are [heatmap_neighbour_start[i], heatmap_neighbour_start[i + 1])
+static heatmap_neighbour_t heatmap_neighbours[RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS_MAX];
+static uint16_t            heatmap_neighbour_start[RGB_MATRIX_LED_COUNT + 1];
+
+static void heatmap_build_neighbours(void) {
+    bool     has_key[RGB_MATRIX_LED_COUNT] = {false};
+    uint16_t count                         = 0;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (g_led_config.matrix_co[row][col] != NO_LED) {
+                has_key[g_led_config.matrix_co[row][col]] = true;
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        heatmap_neighbour_start[i] = count;
+        if (!has_key[i]) {
+            continue;
+        }
+        for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT && count < RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS_MAX; j++) {
+            if (j == i || !has_key[j]) {
+                continue;
+            }
+            int16_t dx = g_led_config.point[i].x - g_led_config.point[j].x;
+            int16_t dy = g_led_config.point[i].y - g_led_config.point[j].y;
+            if (abs(dx) > RGB_MATRIX_TYPING_HEATMAP_SPREAD || abs(dy) > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                continue;
+            }
+            uint8_t distance = sqrt16(dx * dx + dy * dy);
+            if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+                if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                    amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+                }
+                heatmap_neighbours[count++] = (heatmap_neighbour_t){.led = j, .amount = amount};
+            }
+        }
+    }
+    heatmap_neighbour_start[RGB_MATRIX_LED_COUNT] = count;
+}
+#            endif
+
+// Current heat of a led, a led that has cooled down completely is reset so its stamp never wraps around
+static uint8_t heatmap_read(uint8_t led) {
+    uint16_t steps = (uint16_t)((uint16_t)g_rgb_timer - heatmap_stamp[led]) / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+    if (steps >= heatmap_heat[led]) {
+        heatmap_heat[led] = 0;
+        return 0;
+    }
+    return heatmap_heat[led] - steps;
+}
+
+static void heatmap_add(uint8_t led, uint8_t amount) {
+    uint16_t elapsed = (uint16_t)g_rgb_timer - heatmap_stamp[led];
+    uint8_t  heat    = heatmap_read(led);
+    // Keep the phase of a decay step already in progress
+    heatmap_stamp[led] = heat ? (uint16_t)g_rgb_timer - elapsed % RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS : (uint16_t)g_rgb_timer;
+    heatmap_heat[led]  = qadd8(heat, amount);
+}
+
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
+        return;
+    }
+    heatmap_add(led, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+#            ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+    for (uint16_t i = heatmap_neighbour_start[led]; i < heatmap_neighbour_start[led + 1]; i++) {
+        heatmap_add(heatmap_neighbours[i].led, heatmap_neighbours[i].amount);
+    }
+#            endif
+}
+
+bool TYPING_HEATMAP(effect_params_t* params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    if (params->init) {
+        rgb_matrix_set_color_all(0, 0, 0);
+        memset(heatmap_heat, 0, sizeof heatmap_heat);
+#            ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+        if (params->iter == 0) {
+            heatmap_build_neighbours();
+        }
+#            endif
+    }
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        uint8_t val = heatmap_read(i);
+        RGB_MATRIX_TEST_LED_FLAGS();
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+#        else
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
-#        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
+#            ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
     g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-#        else
+#            else
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
@@ -32,9 +148,9 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
             if (i_row == row && i_col == col) {
                 g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
             } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
+#                define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
                 uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
+#                undef LED_DISTANCE
                 if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
                     uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
                     if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
@@ -45,7 +161,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
             }
         }
     }
-#        endif
+#            endif
 }
 
 // A timer to track the last time we decremented all heatmap values.
@@ -95,6 +211,7 @@ bool TYPING_HEATMAP(effect_params_t* params) {
 
     return rgb_matrix_check_finished_leds(led_max);
 }
+#        endif // RGB_MATRIX_TYPING_HEATMAP_LAZY_DECAY
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 #endif     // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -77,6 +77,22 @@ last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_DRIVER_SHUTDOWN_ENABLE
 static bool driver_shutdown = false;
 #endif
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+// Brightness last written to the driver, out of range until the first flush
+static uint16_t driver_brightness = UINT16_MAX;
+#endif
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+_Static_assert(RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT <= UINT8_MAX, "RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT does not fit in rgb_matrix_budget_t.flush_limit");
+_Static_assert(RGB_MATRIX_LED_FLUSH_LIMIT <= RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT, "RGB_MATRIX_LED_FLUSH_LIMIT must not exceed RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT");
+static rgb_matrix_budget_t rgb_budget = {.process_limit = RGB_MATRIX_LED_PROCESS_LIMIT, .flush_limit = RGB_MATRIX_LED_FLUSH_LIMIT};
+static uint32_t            rgb_budget_frame_start;
+static uint16_t            rgb_budget_frame_tasks;
+#    define RGB_MATRIX_FRAME_PROCESS_LIMIT rgb_budget.process_limit
+#    define RGB_MATRIX_FRAME_FLUSH_LIMIT rgb_budget.flush_limit
+#else
+#    define RGB_MATRIX_FRAME_PROCESS_LIMIT RGB_MATRIX_LED_PROCESS_LIMIT
+#    define RGB_MATRIX_FRAME_FLUSH_LIMIT RGB_MATRIX_LED_FLUSH_LIMIT
+#endif
 static bool            suspend_state     = false;
 static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
@@ -90,7 +106,7 @@ static uint32_t rgb_matrix_timeout = RGB_MATRIX_TIMEOUT;
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+static last_hit_ring_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -189,21 +205,17 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
+    // Ring insert, the oldest hit is overwritten once the buffer is full
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
+        uint8_t index                = last_hit_buffer.head;
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        last_hit_buffer.time[index]  = rgb_timer_buffer;
+        last_hit_buffer.head         = (index + 1) % LED_HITS_TO_REMEMBER;
+        if (last_hit_buffer.count < LED_HITS_TO_REMEMBER) {
+            last_hit_buffer.count++;
+        }
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -265,9 +277,9 @@ static bool rgb_matrix_none(effect_params_t *params) {
 }
 
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#if RGB_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#endif // RGB_MATRIX_TIMEOUT > 0
     rgb_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -276,34 +288,75 @@ static void rgb_task_timers(void) {
         rgb_anykey_timer += deltaTime;
     }
 #endif // RGB_MATRIX_TIMEOUT > 0
+}
 
-    // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_task_last_hit_snapshot(void) {
     uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+    uint8_t slot  = (last_hit_buffer.head + LED_HITS_TO_REMEMBER - count) % LED_HITS_TO_REMEMBER;
+
+    // Hits are stored oldest first, so expired ones can only ever be dropped from the tail
+    while (count > 0 && rgb_timer_buffer - last_hit_buffer.time[slot] >= UINT16_MAX) {
+        slot = (slot + 1) % LED_HITS_TO_REMEMBER;
+        count--;
+    }
+    last_hit_buffer.count = count;
+
+    g_last_hit_tracker.count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        g_last_hit_tracker.x[i]     = last_hit_buffer.x[slot];
+        g_last_hit_tracker.y[i]     = last_hit_buffer.y[slot];
+        g_last_hit_tracker.index[i] = last_hit_buffer.index[slot];
+        g_last_hit_tracker.tick[i]  = rgb_timer_buffer - last_hit_buffer.time[slot];
+        slot                        = (slot + 1) % LED_HITS_TO_REMEMBER;
     }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_FRAME_FLUSH_LIMIT) rgb_task_state = STARTING;
+}
+
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+static void rgb_task_budget(void) {
+    if (last_input_activity_elapsed() >= RGB_MATRIX_GOVERNOR_TIMEOUT) {
+        // nobody is typing, render at full quality
+        rgb_budget.process_limit = RGB_MATRIX_LED_PROCESS_LIMIT;
+        rgb_budget.flush_limit   = RGB_MATRIX_LED_FLUSH_LIMIT;
+    } else if (rgb_budget.loop_us > RGB_MATRIX_GOVERNOR_LOOP_US) {
+        // rendering is slowing down the scan, take smaller slices less often
+        rgb_budget.process_limit = MAX(rgb_budget.process_limit / 2, MIN(RGB_MATRIX_GOVERNOR_MIN_PROCESS_LIMIT, RGB_MATRIX_LED_PROCESS_LIMIT));
+        rgb_budget.flush_limit   = MIN(rgb_budget.flush_limit * 2, RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT);
+    } else if (rgb_budget.loop_us < RGB_MATRIX_GOVERNOR_LOOP_US / 2) {
+        // plenty of headroom, work back towards full quality
+        rgb_budget.process_limit = MIN(rgb_budget.process_limit * 2, RGB_MATRIX_LED_PROCESS_LIMIT);
+        rgb_budget.flush_limit   = MAX(rgb_budget.flush_limit / 2, RGB_MATRIX_LED_FLUSH_LIMIT);
+    }
+
+    rgb_budget_frame_start = timer_read32();
+    rgb_budget_frame_tasks = 0;
+}
+
+rgb_matrix_budget_t rgb_matrix_get_budget(void) {
+    return rgb_budget;
 }
+#endif // RGB_MATRIX_RENDER_GOVERNOR
 
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+    // the slice size has to stay the same for all iterations of a frame
+    rgb_task_budget();
+#endif
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    rgb_task_last_hit_snapshot();
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -371,6 +424,10 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+    // average task period between the start of this frame and its flush
+    rgb_budget.loop_us = MIN(timer_elapsed32(rgb_budget_frame_start) * 1000 / rgb_budget_frame_tasks, UINT16_MAX);
+#endif
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
@@ -379,6 +436,14 @@ static void rgb_task_flush(uint8_t effect) {
     if (driver_shutdown) {
         rgb_matrix_driver_exit_shutdown();
     }
+#endif
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    // effects render at full scale, the driver dims everything at once
+    uint8_t brightness = rgb_matrix_driver_global_brightness_kb(rgb_matrix_config.hsv.v);
+    if (brightness != driver_brightness) {
+        rgb_matrix_driver.set_global_brightness(brightness);
+        driver_brightness = brightness;
+    }
 #endif
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
@@ -406,19 +471,32 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+    if (rgb_task_state == RENDERING || rgb_task_state == FLUSHING) {
+        rgb_budget_frame_tasks++;
+    }
+#endif
+
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+            uint8_t val             = rgb_matrix_config.hsv.v;
+            rgb_matrix_config.hsv.v = UINT8_MAX;
+#endif
             rgb_task_render(effect);
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+            rgb_matrix_config.hsv.v = val;
+#endif
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
-            break;
+        } break;
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -442,17 +520,17 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && (RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT || defined(RGB_MATRIX_RENDER_GOVERNOR))
 #    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_FRAME_PROCESS_LIMIT * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_FRAME_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
 #    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_FRAME_PROCESS_LIMIT * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_FRAME_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -493,6 +571,9 @@ void rgb_matrix_init(void) {
 #ifdef RGB_MATRIX_DRIVER_SHUTDOWN_ENABLE
     driver_shutdown = false;
 #endif
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    driver_brightness = UINT16_MAX;
+#endif
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -501,9 +582,7 @@ void rgb_matrix_init(void) {
     }
 
     last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+    last_hit_buffer.head  = 0;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     if (!eeconfig_is_enabled()) {
@@ -821,3 +900,13 @@ __attribute__((weak)) bool rgb_matrix_driver_allow_shutdown(void) {
     return true;
 };
 #endif
+
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+__attribute__((weak)) uint8_t rgb_matrix_driver_global_brightness_kb(uint8_t brightness) {
+    return rgb_matrix_driver_global_brightness_user(brightness);
+}
+
+__attribute__((weak)) uint8_t rgb_matrix_driver_global_brightness_user(uint8_t brightness) {
+    return brightness;
+}
+#endif
@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include "rgb_matrix_types.h"
 #include "color.h"
 #include "keyboard.h"
@@ -48,6 +49,18 @@
 #    include "ws2812.h"
 #endif
 
+/* Random numbers for the effects. RGB_MATRIX_RAND may name another
+ * function returning 0 to RAND_MAX, as the unit tests do. */
+#ifndef RGB_MATRIX_RAND
+#    define RGB_MATRIX_RAND rand
+#else
+int RGB_MATRIX_RAND(void);
+#endif
+
+static inline int rgb_matrix_rand(void) {
+    return RGB_MATRIX_RAND();
+}
+
 #ifndef RGB_MATRIX_TIMEOUT
 #    define RGB_MATRIX_TIMEOUT 0
 #endif
@@ -109,6 +122,22 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+#    ifndef RGB_MATRIX_GOVERNOR_LOOP_US
+#        define RGB_MATRIX_GOVERNOR_LOOP_US 1000
+#    endif
+#    ifndef RGB_MATRIX_GOVERNOR_TIMEOUT
+#        define RGB_MATRIX_GOVERNOR_TIMEOUT 1000
+#    endif
+#    ifndef RGB_MATRIX_GOVERNOR_MIN_PROCESS_LIMIT
+#        define RGB_MATRIX_GOVERNOR_MIN_PROCESS_LIMIT 4
+#    endif
+#    ifndef RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT
+// Capped to what rgb_matrix_budget_t.flush_limit can hold
+#        define RGB_MATRIX_GOVERNOR_MAX_FLUSH_LIMIT (RGB_MATRIX_LED_FLUSH_LIMIT > UINT8_MAX / 4 ? UINT8_MAX : RGB_MATRIX_LED_FLUSH_LIMIT * 4)
+#    endif
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -116,6 +145,16 @@ struct rgb_matrix_limits_t {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+typedef struct {
+    uint8_t  process_limit; // LEDs rendered per task
+    uint8_t  flush_limit;   // milliseconds between frames
+    uint16_t loop_us;       // average task period measured while rendering the last frame
+} rgb_matrix_budget_t;
+
+rgb_matrix_budget_t rgb_matrix_get_budget(void);
+#endif
+
 #define RGB_MATRIX_USE_LIMITS_ITER(min, max, iter)                   \
     struct rgb_matrix_limits_t limits = rgb_matrix_get_limits(iter); \
     uint8_t                    min    = limits.led_min_index;        \
@@ -247,6 +286,10 @@ void rgb_matrix_driver_exit_shutdown(void);
 bool rgb_matrix_is_driver_shutdown(void);
 bool rgb_matrix_driver_allow_shutdown(void);
 #endif
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+uint8_t rgb_matrix_driver_global_brightness_kb(uint8_t brightness);
+uint8_t rgb_matrix_driver_global_brightness_user(uint8_t brightness);
+#endif
 
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_update_rgb_matrix
@@ -307,6 +350,10 @@ typedef struct {
     /* Exit from shutdown state. */
     void (*exit_shutdown)(void);
 #endif
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    /* Scale the output of all LEDs in hardware, 0 is off and 255 is full scale. */
+    void (*set_global_brightness)(uint8_t brightness);
+#endif
 } rgb_matrix_driver_t;
 
 static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
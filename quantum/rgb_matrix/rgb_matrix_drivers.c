@@ -24,6 +24,11 @@
  * be here if shared between boards.
  */
 
+// Only these drivers can scale their current, custom drivers provide set_global_brightness themselves
+#if defined(RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE) && !defined(RGB_MATRIX_IS31FL3733) && !defined(RGB_MATRIX_IS31FL3737) && !defined(RGB_MATRIX_IS31FL3741) && !defined(RGB_MATRIX_SNLED27351) && !defined(RGB_MATRIX_SNLED27351_SPI) && !defined(RGB_MATRIX_CUSTOM)
+#    error "RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE is not supported by this RGB matrix driver"
+#endif
+
 #if defined(RGB_MATRIX_IS31FL3218)
 const rgb_matrix_driver_t rgb_matrix_driver = {
     .init          = is31fl3218_init,
@@ -46,6 +51,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3733_flush,
     .set_color     = is31fl3733_set_color,
     .set_color_all = is31fl3733_set_color_all,
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = is31fl3733_set_global_brightness,
+#endif
 };
 
 #elif defined(RGB_MATRIX_IS31FL3736)
@@ -62,6 +70,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3737_flush,
     .set_color     = is31fl3737_set_color,
     .set_color_all = is31fl3737_set_color_all,
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = is31fl3737_set_global_brightness,
+#endif
 };
 
 #elif defined(RGB_MATRIX_IS31FL3741)
@@ -70,6 +81,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .flush         = is31fl3741_flush,
     .set_color     = is31fl3741_set_color,
     .set_color_all = is31fl3741_set_color_all,
+#ifdef RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE
+    .set_global_brightness = is31fl3741_set_global_brightness,
+#endif
 };
 
 #elif defined(IS31FLCOMMON)
@@ -88,7 +102,10 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .set_color_all = snled27351_set_color_all,
 #        if defined(RGB_MATRIX_DRIVER_SHUTDOWN_ENABLE)
     .shutdown = snled27351_shutdown,
-    .exit_shutdown = snled27351_exit_shutdown
+    .exit_shutdown = snled27351_exit_shutdown,
+#        endif
+#        if defined(RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE)
+    .set_global_brightness = snled27351_set_global_brightness,
 #        endif
 };
 #elif defined(RGB_MATRIX_SNLED27351_SPI)
@@ -99,7 +116,10 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
     .set_color_all = snled27351_set_color_all,
 #        if defined(RGB_MATRIX_DRIVER_SHUTDOWN_ENABLE)
     .shutdown = snled27351_shutdown,
-    .exit_shutdown = snled27351_exit_shutdown
+    .exit_shutdown = snled27351_exit_shutdown,
+#        endif
+#        if defined(RGB_MATRIX_DRIVER_GLOBAL_BRIGHTNESS_ENABLE)
+    .set_global_brightness = snled27351_set_global_brightness,
 #        endif
 };
 #elif defined(RGB_MATRIX_AW20216S)
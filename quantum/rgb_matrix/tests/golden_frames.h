@@ -0,0 +1,386 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+// Number of frames each effect is stepped through
+#define GOLDEN_FRAME_COUNT 32
+
+typedef struct {
+    const char *name;
+    uint32_t    checksums[GOLDEN_FRAME_COUNT];
+} golden_frames_t;
+
+// FNV-1a of every flushed frame, regenerate an entry from the test output when an effect is changed on purpose
+// clang-format off
+static const golden_frames_t golden_frames[] = {
+    {"SOLID_COLOR", {
+        0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85,
+        0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85,
+        0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85,
+        0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85,
+    }},
+    {"ALPHAS_MODS", {
+        0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305,
+        0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305,
+        0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305,
+        0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305, 0xc6ce3305,
+    }},
+    {"GRADIENT_UP_DOWN", {
+        0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21,
+        0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21,
+        0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21,
+        0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21, 0x1b997c21,
+    }},
+    {"GRADIENT_LEFT_RIGHT", {
+        0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127,
+        0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127,
+        0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127,
+        0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127, 0x5b70c127,
+    }},
+    {"BREATHING", {
+        0x75a104c5, 0xb8517c05, 0xf6d65205, 0xf55e5805, 0xf58a1605, 0xcbaa3405, 0xf1f9ca05, 0xc89f7005,
+        0x5e5c0e05, 0xe9dbec05, 0x14556205, 0xa557d585, 0xc127a985, 0x5b3e3b85, 0x46262185, 0x75bcf785,
+        0xe5627585, 0x335efd85, 0x55069d85, 0x06f7e285, 0xc61d8985, 0x7c9c8185, 0x47c84b85, 0x66a1ff05,
+        0x5c1d0605, 0x49d80c05, 0xd4ebad05, 0x78ea1d05, 0xf143a105, 0x6bc88905, 0xe112db05, 0xe7a8c905,
+    }},
+    {"BAND_SAT", {
+        0xe428f85d, 0x1f25371d, 0xae2c611d, 0xaedd88dd, 0x9f11f3dd, 0xd986da7d, 0x9a9603dc, 0x36a8081c,
+        0x0d23e4dc, 0x431d0b1c, 0x20dc7d5c, 0x99b5a41c, 0xcdd84e5c, 0x0272ba7f, 0xabaa50bf, 0x155e307f,
+        0xcf54633f, 0x17fbaa7f, 0x00f6e6bf, 0xd7d0417f, 0x0fc64d46, 0x977e0de6, 0x8c53b1e6, 0xd88884e6,
+        0x2f3d6866, 0xb4c8a6e6, 0x376d5c66, 0x231285e6, 0x42ab3f86, 0x7f69d19e, 0xb8a48969, 0x1c1e2949,
+    }},
+    {"BAND_VAL", {
+        0xf8650e85, 0x8360ffc5, 0xded8d4c5, 0x69d4c605, 0xc54c9b05, 0x430a24a5, 0xd0249aeb, 0x01b6d5fb,
+        0xae34c10b, 0x886a2f9b, 0x363a26ab, 0xad94f73b, 0xa40d2acb, 0x8cf1652d, 0xf060552d, 0x199abc2d,
+        0x44bb402d, 0x6ff920ad, 0x8404f3ad, 0x889ec0ad, 0x280a115b, 0x77ea7a73, 0xa54ac903, 0x385bcb53,
+        0xb17d75e3, 0x652b94b3, 0x858569c3, 0xafaa93e3, 0x045d8b43, 0x8045c24b, 0x1891970d, 0x845d394d,
+    }},
+    {"BAND_PINWHEEL_SAT", {
+        0x5d749fb5, 0x5a409215, 0x4701e5ec, 0x38a0bccd, 0xbe908b9d, 0xdb82d02d, 0x9a03c6a3, 0x3712a5e5,
+        0x49d33942, 0x859974d5, 0x89cecd35, 0x43d4afaa, 0xdf5be2de, 0x91f70dca, 0xa5bd0e8c, 0xbe620f4d,
+        0xa175feb6, 0x0799914d, 0x92ddfbc5, 0xda0d4215, 0x0774a466, 0x7bea9ac5, 0x42307e25, 0xe3019d92,
+        0xa0c8474d, 0x4a45d05d, 0x0d4f1ecd, 0x6f3f2c5d, 0xfebcb4ad, 0x2dd1685c, 0xcf926572, 0xa1c99f86,
+    }},
+    {"BAND_PINWHEEL_VAL", {
+        0x7a6357e4, 0xb8ed541c, 0xbf226042, 0x1f9a9bfa, 0xf28c2802, 0x6746908a, 0xa58e12dd, 0x6a581928,
+        0x4ff1bff8, 0xb3d637e8, 0xa3d315b8, 0x91876599, 0x20f24fb1, 0x7b11cbd7, 0x670c6b8d, 0x1ae34aa2,
+        0xa5619f4a, 0x4f92edd2, 0xf94c51b3, 0x3ba73224, 0x5d620f7c, 0x46720394, 0xdb4f8d5c, 0x817d12e4,
+        0xf96558ea, 0x44e73242, 0x2e3cb83a, 0x00523742, 0x9804f1ca, 0x381e3cf8, 0x83785e28, 0x4f99b3f8,
+    }},
+    {"BAND_SPIRAL_SAT", {
+        0xec83a60a, 0x2efd34a5, 0x6680431d, 0xd2548dad, 0x1cac0aad, 0xc92010e2, 0xa425c5fc, 0xcd8f28a5,
+        0x45349c75, 0x5e625a05, 0xc6d3692c, 0xe7a9f405, 0x5af52975, 0xb3b4875d, 0x2b0297c1, 0x01540a24,
+        0x8810e7bd, 0x15fa425d, 0x25783de5, 0xf6d6571c, 0x88fdcb25, 0xb51ff572, 0xbba038a5, 0xb59a832e,
+        0x73f117dc, 0x76ec6e70, 0x9fe9a92d, 0x04f8392a, 0x4e6729aa, 0x8794dad5, 0xa94f0765, 0x699b51f5,
+    }},
+    {"BAND_SPIRAL_VAL", {
+        0x380dd62d, 0x68ab58f5, 0xb1a580d9, 0x9e4be0a9, 0x80753219, 0xed2fe449, 0x49c920aa, 0x59620855,
+        0x778530ed, 0x870342d5, 0x9250b06a, 0xd354dc95, 0x0980dbed, 0xc3ff3849, 0x22198549, 0x617a8bd2,
+        0x4ea5fcc9, 0xa3075049, 0x2428ae85, 0x95da16e6, 0xfbf89bf5, 0x4b1ec228, 0x8c09bba5, 0x180e96c8,
+        0x83617d69, 0x97052bd9, 0x051d9429, 0xff626d88, 0x2fcc50cc, 0xd2d90edd, 0x9e881a95, 0x142e866d,
+    }},
+    {"CYCLE_ALL", {
+        0x0c5d0b85, 0x632ccd85, 0x45807185, 0xaf149f85, 0x9fa99185, 0x5ac88885, 0xbd027685, 0x1657b685,
+        0x9cec9e85, 0x7beae185, 0x670a2885, 0xa688c685, 0xa5e1f885, 0xabe5ab85, 0x7c087285, 0x12259185,
+        0x88302385, 0xa9200d85, 0xa4621385, 0xd607a385, 0xdb963f85, 0x7fdaf905, 0x7fc33f05, 0x17e05505,
+        0x4535c905, 0x5432b105, 0xcf67a405, 0x20238805, 0x13eadc05, 0xfb077605, 0x55216105, 0x04250505,
+    }},
+    {"CYCLE_LEFT_RIGHT", {
+        0x3fd679d1, 0x3b55d039, 0xc8b83d79, 0xc3fbce29, 0xe7b1574b, 0xc93d59f3, 0xc055703b, 0xa71e5913,
+        0x4b8a244b, 0x8248fe99, 0x2a0ec549, 0x8dc7b039, 0xf70a80c9, 0xac8d5051, 0xbf377b79, 0x317d18c1,
+        0x7ed92549, 0x2b17069f, 0xa7c3160f, 0x0025c66f, 0xe47fbbe3, 0xf9280a1f, 0xd79ad3df, 0xd4a1945f,
+        0x519fcebb, 0xa9b59ca1, 0x2209f0d9, 0x8f399541, 0x9a4b5c69, 0xd56d773b, 0xd4795e6b, 0x02a53a5b,
+    }},
+    {"CYCLE_UP_DOWN", {
+        0xe7559b3d, 0xbc5c812d, 0xf2c3f33d, 0x5843a995, 0x265f74b5, 0x2fe620ed, 0xe2adc2cd, 0xd0bedcfd,
+        0x9ecd7705, 0x17ce6455, 0xcb011095, 0xedb00995, 0x809deeed, 0xf5260be1, 0xbd6f2821, 0x4fd145d1,
+        0x9ea028c7, 0x825ef0c7, 0x4a096827, 0x628c4fa7, 0x17e10e27, 0x1f343007, 0x55413d27, 0x41f8490b,
+        0x81b0c9eb, 0xd66dea0b, 0xe558416b, 0x36f672ab, 0x479e11cb, 0x9ec61453, 0x0f82ff63, 0xf67b4d31,
+    }},
+    {"RAINBOW_MOVING_CHEVRON", {
+        0x6b1ef0c9, 0xf4c3ddc7, 0x09a619c7, 0x492c27c7, 0x1581f7bf, 0xcb349cc3, 0xc97c221b, 0x1032e643,
+        0x1e2a016b, 0xc9b6b68d, 0xe7929f6d, 0x5ceb360d, 0x3dd90241, 0xca1dcd59, 0x577cd911, 0x354cf5e1,
+        0x29374db7, 0x03bf8601, 0xfa2d23e1, 0x60eb9dc7, 0x37495417, 0xd7311121, 0xb78af7e1, 0x049121c1,
+        0x16fad23d, 0x425b95f3, 0xc8a6a433, 0x49116103, 0x33de021b, 0x55c2501d, 0xb0a2c42d, 0x05731055,
+    }},
+    {"CYCLE_OUT_IN", {
+        0x4ad2024f, 0x95be5a6f, 0xdca83e63, 0xdcca0ebb, 0x18c545cf, 0xf1a8b917, 0x060cc737, 0x16814d43,
+        0x29e0ee27, 0x1e368823, 0xf6354ee9, 0xcce48551, 0x7d664a75, 0xfd602945, 0x120cdf51, 0x88b71937,
+        0xc92c6b5f, 0xa4cb51ed, 0x6ea74f59, 0x0da20475, 0xc1b0e2ff, 0xb2312f53, 0x99ed04ab, 0x9514d575,
+        0x0a90f60b, 0x26f8f70f, 0x66e2b2e9, 0xf9d9e465, 0xd2ab8ac7, 0xabdbff05, 0x38f7b9e3, 0xc778aa93,
+    }},
+    {"CYCLE_OUT_IN_DUAL", {
+        0x30ff5ca5, 0x286123b5, 0x2b887b55, 0x011a9319, 0x1a8b5fd5, 0xee38b3fb, 0x5ae5b57f, 0xa45ba701,
+        0xf2dbb189, 0x210541d9, 0xa6841563, 0x5e66ab85, 0x072f9001, 0xbfaf5de9, 0xe7204149, 0x36713d45,
+        0x32d4ca59, 0xf256dfb5, 0xacd94399, 0xbe93fa1b, 0x3edba76b, 0xe9a034b7, 0x50ce7d73, 0x077f0ba9,
+        0x8242a17d, 0x592c069f, 0xaef3ba41, 0xd85f11e7, 0xc8f0f055, 0x15b7e09d, 0xaf555c9f, 0x0d36470b,
+    }},
+    {"CYCLE_PINWHEEL", {
+        0xc5a16ef1, 0xb221636b, 0xcf93f047, 0xe9699093, 0xa811d3af, 0xb1bbc9d7, 0x8acd4a75, 0xe1a85ab1,
+        0xc5beb6c1, 0xb5ab5561, 0x56786ac5, 0x3ab9b395, 0xf82baf35, 0x12c912d9, 0x13ee6c13, 0xea44c8d3,
+        0x36dacfd3, 0x5a08c863, 0x0eae9057, 0x5b623483, 0x31b63db3, 0xf5162331, 0xb033e0eb, 0xa04aa327,
+        0xe7f07f59, 0xcb3b9d3f, 0x5c853a49, 0x05c8fac1, 0x733c8277, 0x9b7901db, 0x066295a5, 0x21eb1f03,
+    }},
+    {"CYCLE_SPIRAL", {
+        0x93016569, 0x7aa7c09b, 0x483b5ec9, 0x35672217, 0x3d10c931, 0xb8735535, 0xcf15aaab, 0x8c2dfed5,
+        0xadfbdbdb, 0x0ba546d9, 0x1a73632b, 0x91093cb3, 0xca68e803, 0xf28dfbf3, 0x4b1bc9b5, 0x858370a3,
+        0x7c88c15b, 0xab6858af, 0x93c0c9bb, 0x9cbeaca1, 0xbcf1214b, 0x842a4ad1, 0xe558b497, 0x03cd1ccb,
+        0x0ef8c20f, 0xec926f11, 0x86e66c9f, 0x5e430dd3, 0xae9541fb, 0x00ea1ac3, 0x29709f9f, 0x796393f3,
+    }},
+    {"DUAL_BEACON", {
+        0x1d666b79, 0x7425eb2b, 0x92e31ec7, 0x17449e69, 0xce66a4ab, 0x83c187e3, 0x6cd891cb, 0x6891a44d,
+        0x568a044d, 0x8c2d100f, 0x699e30ad, 0xf20467a9, 0x09b200a1, 0xe1908e81, 0x02c57641, 0xf2357cd5,
+        0x2dfd14e5, 0x1f727c99, 0x1f6bc433, 0x90bd6c21, 0xc639b297, 0xaa5014a7, 0x3bca1e0b, 0x10fcf2f3,
+        0x9adf2fab, 0xda2e94b1, 0x384929c1, 0x59dc7285, 0xfc5ac67b, 0x32bbc9a5, 0xd5deca21, 0x48721abf,
+    }},
+    {"RAINBOW_BEACON", {
+        0x8e40d889, 0x1a7ebe6f, 0xfc728085, 0xcc163a1d, 0xd226b961, 0x3175e451, 0x788555f7, 0xdee565df,
+        0x6b6f10f3, 0x02ce908d, 0x352e82fb, 0x287b51c3, 0x049129f7, 0x0a38cd27, 0x46f5b7c5, 0xb8cb62b3,
+        0xc679ec1b, 0x40940507, 0xaa0f8dbf, 0xec7a2c0f, 0xc07ff2c7, 0x0078950b, 0xdf5719a7, 0x5c32b0f7,
+        0x69699f35, 0x527ee179, 0x51a15485, 0x8b0d3077, 0x30a25b41, 0xebd582cb, 0xeb7b2e21, 0xc57880cb,
+    }},
+    {"RAINBOW_PINWHEELS", {
+        0x8e968015, 0x973cf41d, 0x8112ec51, 0x861002bb, 0x9d28a8b7, 0x3d3612ff, 0x88285fa1, 0xd9120b67,
+        0x66432725, 0xd3a1bfad, 0x1e717249, 0x3494ff5f, 0xe585c8ab, 0x0a8aaac1, 0x0a12982b, 0xcbce1b93,
+        0x49559d7d, 0x77dfe843, 0xe22864f9, 0x2e67e37d, 0x3ddac85b, 0x13809aa7, 0xce035f9d, 0xfe048421,
+        0xb1723e4b, 0xd835352f, 0x6f0de435, 0x3b62f519, 0xc32005cf, 0x0941cc5d, 0x53cebc0f, 0x318a8b0f,
+    }},
+    {"FLOWER_BLOOMING", {
+        0x355b8d21, 0x7664af25, 0x7664af25, 0x5fece187, 0x1246890d, 0xb1454c8f, 0xe9866d83, 0xc60ce895,
+        0x7a5233e3, 0x7a5233e3, 0x8449fdc3, 0x572634ff, 0x4525a22f, 0xf4c3915b, 0x6961640f, 0x8f5f87bf,
+        0x8f5f87bf, 0x4f973537, 0xcdd20223, 0xcbd5408f, 0x29ffa1e3, 0x0836dc23, 0x66ce5177, 0x941492af,
+        0x941492af, 0x0f11ea5b, 0x5ab2ec2f, 0xe02bdf8b, 0x3dedcf77, 0x5288996f, 0x19ebfee7, 0x19ebfee7,
+    }},
+    {"RAINDROPS", {
+        0xd95aa647, 0xd95aa647, 0x7d1ecf35, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3,
+        0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3,
+        0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0xbd9dcfc3, 0x620b3a13, 0xb336600f,
+        0xb336600f, 0xb336600f, 0xb336600f, 0xb336600f, 0xb336600f, 0xb336600f, 0xb336600f, 0xb336600f,
+    }},
+    {"JELLYBEAN_RAINDROPS", {
+        0x94b6ad10, 0x94b6ad10, 0x429bc72e, 0x5ee818f3, 0x5ee818f3, 0x5ee818f3, 0x5ee818f3, 0x5ee818f3,
+        0x5ee818f3, 0x5ee818f3, 0x5ee818f3, 0x5ee818f3, 0xb8b62f92, 0xf363de9a, 0xf363de9a, 0xf363de9a,
+        0xf363de9a, 0xf363de9a, 0xf363de9a, 0xf363de9a, 0xf363de9a, 0xf363de9a, 0x02c3c1c4, 0x76842894,
+        0x76842894, 0x76842894, 0x76842894, 0x76842894, 0x76842894, 0x76842894, 0x76842894, 0x76842894,
+    }},
+    {"HUE_BREATHING", {
+        0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0xd29ca785, 0xd29ca785, 0xd29ca785, 0xd29ca785,
+        0x632ccd85, 0x632ccd85, 0x632ccd85, 0xd23bd185, 0xd23bd185, 0xd23bd185, 0xd23bd185, 0x45807185,
+        0x45807185, 0x45807185, 0xf5b3a985, 0xf5b3a985, 0xf5b3a985, 0xf5b3a985, 0xaf149f85, 0xaf149f85,
+        0xaf149f85, 0xaf149f85, 0xaf149f85, 0x5562e785, 0x5562e785, 0x5562e785, 0x5562e785, 0x9fa99185,
+    }},
+    {"HUE_PENDULUM", {
+        0x130bf5a9, 0x62ec8a21, 0x6611b051, 0xa043f3a7, 0xe2566b5d, 0xd0838c51, 0x987ee6a9, 0x6b44ef3d,
+        0x863fcddb, 0x7ff1b51f, 0x5471e719, 0x2b0f4cfd, 0x83ec0c07, 0x00ae21bf, 0xddbcc02b, 0x505ed995,
+        0xc60a34bf, 0x3b47bea1, 0xcd256aa1, 0x59ec4b65, 0xef573873, 0xec237c6d, 0x0f77d1a1, 0x34b7e3a9,
+        0xb49d0557, 0x1ab18e3f, 0x1ab18e3f, 0xc78e505f, 0x67da18cd, 0xcf216e79, 0xe57043d1, 0xcf216e79,
+    }},
+    {"HUE_WAVE", {
+        0x130bf5a9, 0x3908cbdb, 0x65e38871, 0x70ca01b3, 0xcc4312a3, 0x77998529, 0x9dbb8811, 0x14b1de6d,
+        0x40071c8b, 0x9d831411, 0xa428b8eb, 0x34c339e5, 0xefe89f65, 0x33be2a33, 0x65e5d485, 0x5a2a5301,
+        0xa8291faf, 0x30d84847, 0x98135b79, 0x293a88b5, 0x32e86dd3, 0xa6f07011, 0xa271e43d, 0xf2996a95,
+        0xa73e6573, 0x1d414bf7, 0x27f49825, 0x4bf58597, 0x86b96389, 0xbab2a125, 0xd30c5731, 0x64eda571,
+    }},
+    {"PIXEL_RAIN", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5,
+        0xf0ff0d1b, 0xf0ff0d1b, 0xf0ff0d1b, 0xf0ff0d1b, 0x1684db41, 0x1684db41, 0x1684db41, 0x1684db41,
+        0x25b3eabc, 0x25b3eabc, 0x25b3eabc, 0x25b3eabc, 0x25b3eabc, 0x25b3eabc, 0x25b3eabc, 0x25b3eabc,
+        0x192b8c46, 0x192b8c46, 0x192b8c46, 0x192b8c46, 0x192b8c46, 0x192b8c46, 0x192b8c46, 0x192b8c46,
+    }},
+    {"PIXEL_FLOW", {
+        0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed,
+        0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed,
+        0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x4898e9ed, 0x45ada29b,
+        0x45ada29b, 0x45ada29b, 0x45ada29b, 0x45ada29b, 0x45ada29b, 0x45ada29b, 0x45ada29b, 0x45ada29b,
+    }},
+    {"PIXEL_FRACTAL", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5,
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5,
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x4d0cb858,
+        0x4d0cb858, 0x4d0cb858, 0x4d0cb858, 0x4d0cb858, 0x4d0cb858, 0x4d0cb858, 0x4d0cb858, 0x4d0cb858,
+    }},
+#ifdef RGB_MATRIX_TYPING_HEATMAP_LAZY_DECAY
+    {"TYPING_HEATMAP", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x4b2512aa, 0x848ec6c1, 0x979d8081, 0x979d8081,
+        0xb8947726, 0x46031559, 0x62a092b1, 0x67698f6f, 0x6766514e, 0x511a3d47, 0x04a33237, 0xbd79c510,
+        0xebfdcb37, 0x23d9156c, 0xd19e2681, 0x07152f58, 0xaa7eff0c, 0x26ce4cea, 0x5f8bd020, 0x99629dfe,
+        0xb2b25466, 0xd23e9dff, 0x2f9c08e5, 0x91952953, 0x9a0b414e, 0xcb9679a5, 0x4db26f41, 0x495666a1,
+    }},
+#else
+    {"TYPING_HEATMAP", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x4b2512aa, 0x848ec6c1, 0x848ec6c1, 0x979d8081,
+        0x0fbafbfd, 0x2037e532, 0x2037e532, 0x62a092b1, 0x6d33cbbd, 0x27d9d25b, 0x27d9d25b, 0x1d47d38b,
+        0x8d35b098, 0x1a060191, 0x1a060191, 0x81b5214a, 0x30b3a78a, 0x55da80b4, 0x55da80b4, 0x009a4606,
+        0x8a9dd2b9, 0x10c80171, 0x10c80171, 0x4773407f, 0x0a82c147, 0xcc441ce2, 0xcc441ce2, 0x3f3b6941,
+    }},
+#endif
+    {"DIGITAL_RAIN", {
+        0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326,
+        0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326,
+        0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326,
+        0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xcc612326, 0xf5c30177, 0x77aa1403, 0xfac0450b,
+    }},
+    {"SOLID_REACTIVE_SIMPLE", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x9fe9aed4, 0xfb539435, 0x078e85dd, 0x9be7da82,
+        0x82df1063, 0xb065801b, 0x56629cbb, 0x45b44a7f, 0x24ce08bc, 0xf3294487, 0x66bbe0df, 0x6ac14eda,
+        0x54a6d0c3, 0x7bb847bd, 0xff12400d, 0x0ee62247, 0x50f348ac, 0x7df5455d, 0x014997d5, 0x5e3d22aa,
+        0xfe1eab85, 0x0f8e81cb, 0x1bdd674b, 0xffc113fd, 0x4d0a275c, 0xd9d0f41f, 0x5f18ea77, 0x3ae06a6a,
+    }},
+    {"SOLID_REACTIVE", {
+        0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x0c5d0b85, 0x9927ea1f, 0xd8f110c9, 0xbf3f9df9, 0xf5653983,
+        0xb84d897d, 0xcebde3dd, 0xdae97dbd, 0x72048e6d, 0xf54e6b9f, 0xfc15bafd, 0x9c7406b1, 0xdce343ef,
+        0xd8e1eab9, 0x9912cad9, 0xdf111a59, 0x5169a063, 0xf7036255, 0xd5facc9d, 0xe3bd9895, 0xe233db9f,
+        0x23ff0c01, 0xc7889e8d, 0x00e7af01, 0x405e372f, 0x06d12bb9, 0x58163075, 0x354ec001, 0x0e93fe73,
+    }},
+    {"SOLID_REACTIVE_WIDE", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0xbd54dfce, 0x0e387ddc, 0x8ca7978b, 0x8546047e,
+        0x93a389e6, 0xc93c6c2c, 0x80d3e784, 0xb035d6a4, 0x47a0fec0, 0xa9e67529, 0x346e9e74, 0xdb7ed510,
+        0xe3c49f32, 0xe9ae01e2, 0xc548b562, 0xd81a31ee, 0xb238a859, 0xbe581f53, 0x972c1a26, 0x20eeeef3,
+        0x1b5d858c, 0xa51ded3e, 0x932f657e, 0xb66cb379, 0x268c7cab, 0xaa387d18, 0x02adad8f, 0x6c400e7b,
+    }},
+    {"SOLID_REACTIVE_MULTIWIDE", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0xbd54dfce, 0x0e387ddc, 0x8ca7978b, 0x8546047e,
+        0xc86817f5, 0x43d8c146, 0xb53d8f06, 0x771963f4, 0xace933a4, 0x2434cc90, 0xcd52707c, 0xb7331933,
+        0x1c88916a, 0x228b816b, 0xd0a0baf4, 0x4af83bdc, 0xc19c08b5, 0xbf2a5c72, 0xd9405b74, 0x294402df,
+        0x381c281a, 0x0bf2672d, 0xe61d3f60, 0xb9075a55, 0x694af9dc, 0x1b0b34f8, 0x17432b1b, 0xc6aa82f3,
+    }},
+    {"SOLID_REACTIVE_CROSS", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x090008de, 0xb4d07140, 0x4c068d10, 0x6f9aaabe,
+        0x0a9546f5, 0x5bb30270, 0x731c2808, 0x3c47855b, 0x06a084c4, 0xea180c76, 0x5a88be66, 0xb24034c0,
+        0x7e148f72, 0xf438346c, 0xb80d383c, 0x9ddceeae, 0xc0c0024c, 0xe5bf8113, 0xf02bbc1b, 0x1bcc6ed6,
+        0x3781a805, 0xcef1d56a, 0x653b4d32, 0xe027e65b, 0xdb45b394, 0xddbe609c, 0x9369c04c, 0x84eed85c,
+    }},
+    {"SOLID_REACTIVE_MULTICROSS", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x090008de, 0xb4d07140, 0x4c068d10, 0x6f9aaabe,
+        0x27a635b7, 0xd006360e, 0xc1f1e276, 0x8b063079, 0x773714c2, 0xd2198418, 0xdfc9a82b, 0x84fd6267,
+        0x113e1cdc, 0xce7f17bd, 0xcc5336d3, 0x98a77c75, 0x6d10740f, 0x380b7d7c, 0x06fea568, 0x30da56c4,
+        0xc2ec029c, 0x849c3408, 0x757cdaec, 0xb1641fe8, 0x519bde8a, 0x75bf17eb, 0x15d096b7, 0xa44d13a7,
+    }},
+    {"SOLID_REACTIVE_NEXUS", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x9fe9aed4, 0xfb539435, 0x95db4b15, 0x6855043c,
+        0x773062ac, 0x51fdef95, 0xaac5afa2, 0xc7580d98, 0xf0065722, 0x6fa6b1f5, 0xc783c45f, 0x68100e5c,
+        0x47e95a64, 0x44dd1bd5, 0x98ebefb4, 0x76d1012e, 0xf8ea54aa, 0x40d0e475, 0x37da0ed7, 0xf12fcb58,
+        0x97455592, 0x776a0f95, 0xe708adee, 0x37bd385c, 0x59a7e8f4, 0x181fa775, 0x9a691477, 0xcd2f8e12,
+    }},
+    {"SOLID_REACTIVE_MULTINEXUS", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x9fe9aed4, 0xfb539435, 0x95db4b15, 0x6855043c,
+        0xe4fb0ef7, 0x7e9a2ca4, 0xb6b96f46, 0xfe034ce6, 0x79796233, 0xb03514bd, 0x1af925a3, 0xdea7be2e,
+        0x83d34865, 0x3dc560cb, 0x391b2ba1, 0x64fd190b, 0xd35c898f, 0x40ffe632, 0x71b8fd86, 0x369a7bca,
+        0x791b2dfe, 0x216e4ef7, 0x0bbe8d42, 0xb5a72366, 0x089542b1, 0xa63a885c, 0x5df32a97, 0x7ca70592,
+    }},
+    {"SPLASH", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0xa7055e46, 0xa03e0c18, 0xcd46efda, 0x29bb49b9,
+        0xe3e3bbde, 0x62ee4690, 0x9b118365, 0xb1796da2, 0x017efb4c, 0x4a0ab602, 0xc2bebd43, 0xa9c6f978,
+        0x1076c756, 0x6c2e8d68, 0xf7053ca2, 0xb39ffd73, 0x13597f14, 0x24da9d6a, 0xab496e3f, 0xc32f6984,
+        0x3187a97c, 0x6318a6f2, 0xb7c697a8, 0xc9d55f4b, 0xe6b4d0a6, 0x377f6438, 0xb039db0f, 0x72dde5c6,
+    }},
+    {"MULTISPLASH", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0xa7055e46, 0xa03e0c18, 0xcd46efda, 0x29bb49b9,
+        0x187faa5c, 0x259bfdff, 0x9b341c81, 0xeabd75e3, 0x2fc17702, 0xa9c2d2b1, 0xa1fff3fc, 0xe2dfdb97,
+        0x84d3589c, 0x0f2e1080, 0xed793598, 0x7c4bd2fc, 0x7cfcb35e, 0xe575c53a, 0x22c35990, 0xa3ef8ca6,
+        0x4c0b63ce, 0xa3d9477f, 0x7ddf561c, 0xcabc98e4, 0x656d7d2a, 0x806ddde2, 0x9f0465d0, 0x9fd0d6d3,
+    }},
+    {"SOLID_SPLASH", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x9fe9aed4, 0xfb539435, 0xdbbddbbd, 0x59135a27,
+        0x773062ac, 0x51fdef95, 0xf4b3c90a, 0x94dccacd, 0xf0065722, 0x6fa6b1f5, 0x94ed4ed5, 0x06ea48ca,
+        0x47e95a64, 0x44dd1bd5, 0xb856822a, 0x9dc7a040, 0xf8ea54aa, 0x40d0e475, 0x00db3615, 0xe3ab4eda,
+        0x97455592, 0x776a0f95, 0x44e80fa4, 0x79f2c04e, 0x59a7e8f4, 0x181fa775, 0x5aee06b5, 0x0c93c91c,
+    }},
+    {"SOLID_MULTISPLASH", {
+        0x75a104c5, 0x75a104c5, 0x75a104c5, 0x75a104c5, 0x9fe9aed4, 0xfb539435, 0xdbbddbbd, 0x59135a27,
+        0x4efb830b, 0x00b1714e, 0x3fe483bd, 0x92b21fe2, 0xbd68d6e7, 0xc373d9a0, 0xf1ae76ad, 0x5c9fe48e,
+        0xdae6005d, 0x5eea48d8, 0x29f1eabc, 0x6d884663, 0xd6fb4ab5, 0x09a5b8ea, 0x35d08ba7, 0xcf338828,
+        0xf4034fbd, 0xd9a41ec5, 0xd9a41ec5, 0xd9a41ec5, 0xd9a41ec5, 0xd9a41ec5, 0xd9a41ec5, 0xd9a41ec5,
+    }},
+    {"STARLIGHT", {
+        0x75a104c5, 0x1bd01508, 0x1bd01508, 0x1bd01508, 0x1bd01508, 0xdf208083, 0xdf208083, 0xdf208083,
+        0xdf208083, 0xad6965b4, 0xad6965b4, 0xad6965b4, 0xad6965b4, 0xc5e8fbe9, 0xc5e8fbe9, 0xc5e8fbe9,
+        0xc5e8fbe9, 0xd8692d68, 0xd8692d68, 0xd8692d68, 0xd8692d68, 0x9d909c2f, 0x9d909c2f, 0x9d909c2f,
+        0x9d909c2f, 0x31388ed6, 0x31388ed6, 0x31388ed6, 0x31388ed6, 0x67290c85, 0x67290c85, 0x67290c85,
+    }},
+    {"STARLIGHT_DUAL_SAT", {
+        0x75a104c5, 0x7f5d2f50, 0x7f5d2f50, 0x7f5d2f50, 0x7f5d2f50, 0xacde6619, 0xacde6619, 0xacde6619,
+        0xacde6619, 0x01accc67, 0x01accc67, 0x01accc67, 0x01accc67, 0xc73777b6, 0xc73777b6, 0xc73777b6,
+        0xc73777b6, 0x834bdabd, 0x834bdabd, 0x834bdabd, 0x834bdabd, 0x447fb578, 0x447fb578, 0x447fb578,
+        0x447fb578, 0x8accb65c, 0x8accb65c, 0x8accb65c, 0x8accb65c, 0xf53c8bc8, 0xf53c8bc8, 0xf53c8bc8,
+    }},
+    {"STARLIGHT_DUAL_HUE", {
+        0x75a104c5, 0x211861eb, 0x211861eb, 0x211861eb, 0x211861eb, 0xd862ce1b, 0xd862ce1b, 0xd862ce1b,
+        0xd862ce1b, 0xaf03d0ee, 0xaf03d0ee, 0xaf03d0ee, 0xaf03d0ee, 0x1f1e2ea2, 0x1f1e2ea2, 0x1f1e2ea2,
+        0x1f1e2ea2, 0x7846f4ea, 0x7846f4ea, 0x7846f4ea, 0x7846f4ea, 0x709b46da, 0x709b46da, 0x709b46da,
+        0x709b46da, 0xf4e65280, 0xf4e65280, 0xf4e65280, 0xf4e65280, 0xbc59440d, 0xbc59440d, 0xbc59440d,
+    }},
+    {"RIVERFLOW", {
+        0xa2075262, 0x1a11c7d7, 0x1775fecd, 0x5327c2c3, 0xa56c93af, 0xd19baf3d, 0xec4dbf99, 0xbeb05127,
+        0xe96798ea, 0x0fbb664a, 0x7c159f26, 0x0e576de5, 0x9f683a5a, 0xd8d6bd6c, 0x59568a00, 0xcd2530b8,
+        0xd2170498, 0x65ae9c07, 0xbaa1c3ca, 0x0abf814f, 0x8352830d, 0x88d43c75, 0x941ffc49, 0x3127c28f,
+        0xa2080e47, 0x555f6f47, 0xa183bf3d, 0x6636e0fa, 0xc6c6d25e, 0xf5ec55b4, 0x669ade46, 0x7cab2f44,
+    }},
+};
+
+// Reactive splash effects hit with faded hits in every frame, see run_faded_hits()
+static const golden_frames_t faded_golden_frames[] = {
+    {"SOLID_REACTIVE_WIDE", {
+        0x75a104c5, 0x46f8f0a5, 0x3e775692, 0x6c23767d, 0xa2b32766, 0x36068edd, 0x5814aa18, 0x5cb36635,
+        0xf62358db, 0x80f42f70, 0x75a104c5, 0x46f8f0a5, 0x3e775692, 0x6c23767d, 0xa2b32766, 0x36068edd,
+        0x5814aa18, 0x5cb36635, 0xf62358db, 0x80f42f70, 0x75a104c5, 0x46f8f0a5, 0x3e775692, 0x6c23767d,
+        0xa2b32766, 0x36068edd, 0x5814aa18, 0x5cb36635, 0xf62358db, 0x80f42f70, 0x75a104c5, 0x46f8f0a5,
+    }},
+    {"SOLID_REACTIVE_MULTIWIDE", {
+        0x75a104c5, 0x46f8f0a5, 0x3e775692, 0x6c23767d, 0xa2b32766, 0x36068edd, 0x5814aa18, 0x5cb36635,
+        0xf62358db, 0x80f42f70, 0x75a104c5, 0x46f8f0a5, 0x3e775692, 0x6c23767d, 0xa2b32766, 0x36068edd,
+        0x5814aa18, 0x5cb36635, 0xf62358db, 0x80f42f70, 0x75a104c5, 0x46f8f0a5, 0x3e775692, 0x6c23767d,
+        0xa2b32766, 0x36068edd, 0x5814aa18, 0x5cb36635, 0xf62358db, 0x80f42f70, 0x75a104c5, 0x46f8f0a5,
+    }},
+    {"SOLID_REACTIVE_CROSS", {
+        0x75a104c5, 0x15f89420, 0x096275e4, 0x768b7a76, 0xd02e225c, 0x9b57ff03, 0x64f75cfe, 0x67232bbc,
+        0x06679d26, 0xb65bb513, 0x75a104c5, 0x15f89420, 0x096275e4, 0x768b7a76, 0xd02e225c, 0x9b57ff03,
+        0x64f75cfe, 0x67232bbc, 0x06679d26, 0xb65bb513, 0x75a104c5, 0x15f89420, 0x096275e4, 0x768b7a76,
+        0xd02e225c, 0x9b57ff03, 0x64f75cfe, 0x67232bbc, 0x06679d26, 0xb65bb513, 0x75a104c5, 0x15f89420,
+    }},
+    {"SOLID_REACTIVE_MULTICROSS", {
+        0x75a104c5, 0x15f89420, 0x096275e4, 0x768b7a76, 0xd02e225c, 0x9b57ff03, 0x64f75cfe, 0x67232bbc,
+        0x06679d26, 0xb65bb513, 0x75a104c5, 0x15f89420, 0x096275e4, 0x768b7a76, 0xd02e225c, 0x9b57ff03,
+        0x64f75cfe, 0x67232bbc, 0x06679d26, 0xb65bb513, 0x75a104c5, 0x15f89420, 0x096275e4, 0x768b7a76,
+        0xd02e225c, 0x9b57ff03, 0x64f75cfe, 0x67232bbc, 0x06679d26, 0xb65bb513, 0x75a104c5, 0x15f89420,
+    }},
+    {"SOLID_REACTIVE_NEXUS", {
+        0x75a104c5, 0x9936b172, 0x81a26e07, 0xb43b153e, 0x27bb6a57, 0xef55d28a, 0x9b49ef73, 0x9db7ebf8,
+        0xd95e00c7, 0x06cb62a9, 0x934f87ca, 0x9936b172, 0x81a26e07, 0xb43b153e, 0x27bb6a57, 0xef55d28a,
+        0x9b49ef73, 0x9db7ebf8, 0xd95e00c7, 0x06cb62a9, 0x934f87ca, 0x9936b172, 0x81a26e07, 0xb43b153e,
+        0x27bb6a57, 0xef55d28a, 0x9b49ef73, 0x9db7ebf8, 0xd95e00c7, 0x06cb62a9, 0x934f87ca, 0x9936b172,
+    }},
+    {"SOLID_REACTIVE_MULTINEXUS", {
+        0x75a104c5, 0x9936b172, 0x78505eac, 0x449d19be, 0xbbb91e23, 0xd88414d8, 0x7d2aca53, 0xe484fc60,
+        0xccf98bea, 0x7643f92a, 0x934f87ca, 0x9936b172, 0x78505eac, 0x449d19be, 0xbbb91e23, 0xd88414d8,
+        0x7d2aca53, 0xe484fc60, 0xccf98bea, 0x7643f92a, 0x934f87ca, 0x9936b172, 0x78505eac, 0x449d19be,
+        0xbbb91e23, 0xd88414d8, 0x7d2aca53, 0xe484fc60, 0xccf98bea, 0x7643f92a, 0x934f87ca, 0x9936b172,
+    }},
+    {"SPLASH", {
+        0x75a104c5, 0xc54e7145, 0x4ddee00a, 0xeddffa60, 0x75c74067, 0x163e45a4, 0xdb25c69b, 0x556e8466,
+        0xc4e1781a, 0x12e14d26, 0xf02fc4cb, 0xc54e7145, 0x4ddee00a, 0xeddffa60, 0x75c74067, 0x163e45a4,
+        0xdb25c69b, 0x556e8466, 0xc4e1781a, 0x12e14d26, 0xf02fc4cb, 0xc54e7145, 0x4ddee00a, 0xeddffa60,
+        0x75c74067, 0x163e45a4, 0xdb25c69b, 0x556e8466, 0xc4e1781a, 0x12e14d26, 0xf02fc4cb, 0xc54e7145,
+    }},
+    {"MULTISPLASH", {
+        0x75a104c5, 0xc54e7145, 0xf69231d8, 0x4aeff84d, 0x80ad11e2, 0x2c509a32, 0x2d6833db, 0x61049a7b,
+        0xd0ee04f7, 0x83640c1d, 0x78ffffee, 0xc3dcfd95, 0x5cfcaf64, 0xd657b9ba, 0xf8c3f2f8, 0x751ee94f,
+        0x6fb5fe06, 0x5910ce65, 0xd0ee04f7, 0x83640c1d, 0x78ffffee, 0xc3dcfd95, 0x5cfcaf64, 0xd657b9ba,
+        0xf8c3f2f8, 0x751ee94f, 0x6fb5fe06, 0x5910ce65, 0xd0ee04f7, 0x83640c1d, 0x78ffffee, 0xc3dcfd95,
+    }},
+    {"SOLID_SPLASH", {
+        0x75a104c5, 0x61d263b9, 0xcca42534, 0x120a4aae, 0x9d5faa14, 0x4d8bd233, 0xe218aa54, 0x097df720,
+        0xb882bb13, 0xa96893ff, 0x6736cafa, 0x61d263b9, 0xcca42534, 0x120a4aae, 0x9d5faa14, 0x4d8bd233,
+        0xe218aa54, 0x097df720, 0xb882bb13, 0xa96893ff, 0x6736cafa, 0x61d263b9, 0xcca42534, 0x120a4aae,
+        0x9d5faa14, 0x4d8bd233, 0xe218aa54, 0x097df720, 0xb882bb13, 0xa96893ff, 0x6736cafa, 0x61d263b9,
+    }},
+    {"SOLID_MULTISPLASH", {
+        0x75a104c5, 0x61d263b9, 0xfb188ba9, 0x6ceda994, 0xff849d4d, 0x961a4af9, 0x42118dbd, 0x8d2d03e8,
+        0xcaed2391, 0xc50f3d00, 0xf88e4978, 0x067ac520, 0xfb188ba9, 0x6ceda994, 0xff849d4d, 0x961a4af9,
+        0x42118dbd, 0x8d2d03e8, 0xcaed2391, 0xc50f3d00, 0xf88e4978, 0x067ac520, 0xfb188ba9, 0x6ceda994,
+        0xff849d4d, 0x961a4af9, 0x42118dbd, 0x8d2d03e8, 0xcaed2391, 0xc50f3d00, 0xf88e4978, 0x067ac520,
+    }},
+};
+// clang-format on
@@ -0,0 +1,144 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdlib.h>
+#include <string.h>
+#include <lib/lib8tion/lib8tion.h>
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+#include "timer.h"
+#include "mock.h"
+
+// clang-format off
+#define __ NO_LED
+
+// Keychron Q15 Max (ANSI encoder), with the flags split into alphas and
+// modifiers so that ALPHAS_MODS has something to tell apart
+led_config_t g_led_config = {
+    {
+        { __,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, __ },
+        { 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25 },
+        { 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, __ },
+        { 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52 },
+        { 53, 54, 55, 56, 57, __, __, 58, __, 59, 60, 61, 62, 63 },
+    },
+    {
+               {17,0}, {34,0}, {51,0}, {68,0}, {84,0}, {102,0}, {119,0}, {136,0}, {153,0}, {170,0}, {187,0}, {204,0},
+        {0,16},{17,16},{34,16},{51,16},{68,16},{84,16},{102,16},{119,16},{136,16},{153,16},{170,16},{187,16},{204,16},{220,16},
+        {0,32},{17,32},{34,32},{51,32},{68,32},{84,32},{102,32},{119,32},{136,32},{153,32},{170,32},{187,32},         {212,32},
+        {0,48},{17,48},{34,48},{51,48},{68,48},{84,48},{102,48},{119,48},{136,48},{153,48},{170,48},{187,48},{204,48},{220,48},
+        {0,64},{17,64},{34,64},{51,64},{76,64},                 {121,64},         {153,64},{170,64},{187,64},{204,64},{220,64},
+    },
+    {
+           4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,    1,
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 1, 1,
+        1, 1, 1, 1, 4,       4,    1, 1, 1, 1, 1,
+    }
+};
+
+#define RGB_MATRIX_EFFECT(name, ...) {RGB_MATRIX_##name, #name},
+const rgb_matrix_mock_effect_t rgb_matrix_mock_effects[] = {
+#include "rgb_matrix_effects.inc"
+};
+#undef RGB_MATRIX_EFFECT
+// clang-format on
+
+const uint8_t rgb_matrix_mock_effect_count = ARRAY_SIZE(rgb_matrix_mock_effects);
+
+uint8_t                 rgb_matrix_mock_pushed[RGB_MATRIX_LED_COUNT][3];
+rgb_matrix_mock_stats_t rgb_matrix_mock_stats;
+
+static uint8_t pwm_buffer[RGB_MATRIX_LED_COUNT][3];
+static uint8_t eeprom[EECONFIG_SIZE];
+
+void rgb_matrix_mock_reset(void) {
+    memset(pwm_buffer, 0, sizeof(pwm_buffer));
+    memset(rgb_matrix_mock_pushed, 0, sizeof(rgb_matrix_mock_pushed));
+    memset(&rgb_matrix_mock_stats, 0, sizeof(rgb_matrix_mock_stats));
+}
+
+// Fixed LCG behind rgb_matrix_rand(), see config_mock.h
+static uint32_t rand_state;
+
+int rgb_matrix_mock_rand(void) {
+    rand_state = rand_state * 1664525 + 1013904223;
+    // Top 31 bits, fewer when the host RAND_MAX is smaller
+    return (rand_state >> 1) / (0x80000000 / ((uint32_t)RAND_MAX + 1));
+}
+
+void rgb_matrix_mock_seed(uint16_t seed) {
+    rand_state = seed;
+    random16_set_seed(seed);
+}
+
+static void mock_init(void) {
+    rgb_matrix_mock_reset();
+}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    rgb_matrix_mock_stats.set_color_calls++;
+    pwm_buffer[index][0] = r;
+    pwm_buffer[index][1] = g;
+    pwm_buffer[index][2] = b;
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        mock_set_color(i, r, g, b);
+    }
+}
+
+static void mock_flush(void) {
+    rgb_matrix_mock_stats.flushes++;
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        for (int c = 0; c < 3; c++) {
+            if (rgb_matrix_mock_pushed[i][c] != pwm_buffer[i][c]) {
+                rgb_matrix_mock_stats.bytes_flushed++;
+                rgb_matrix_mock_pushed[i][c] = pwm_buffer[i][c];
+            }
+        }
+    }
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .flush         = mock_flush,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+};
+
+bool is_keyboard_master(void) {
+    return true;
+}
+
+bool eeconfig_is_enabled(void) {
+    return true;
+}
+
+void eeconfig_init(void) {}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    memcpy(buf, &eeprom[(uintptr_t)addr], len);
+}
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    memcpy(&eeprom[(uintptr_t)addr], buf, len);
+}
+
+uint32_t rgb_matrix_mock_input_time;
+
+uint32_t last_input_activity_elapsed(void) {
+    return timer_elapsed32(rgb_matrix_mock_input_time);
+}
+
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+uint8_t rgb_matrix_mock_process_limit(void) {
+    return rgb_matrix_get_budget().process_limit;
+}
+
+uint8_t rgb_matrix_mock_flush_limit(void) {
+    return rgb_matrix_get_budget().flush_limit;
+}
+#endif
@@ -0,0 +1,38 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint8_t     mode;
+    const char *name;
+} rgb_matrix_mock_effect_t;
+
+typedef struct {
+    uint32_t set_color_calls;
+    uint32_t flushes;
+    uint32_t bytes_flushed; // PWM bytes which changed since the previous flush
+} rgb_matrix_mock_stats_t;
+
+// Last colours pushed to the "hardware" by a flush
+extern uint8_t                 rgb_matrix_mock_pushed[RGB_MATRIX_LED_COUNT][3];
+extern rgb_matrix_mock_stats_t rgb_matrix_mock_stats;
+
+// Every effect enabled by config_mock.h, in enum order
+extern const rgb_matrix_mock_effect_t rgb_matrix_mock_effects[];
+extern const uint8_t                  rgb_matrix_mock_effect_count;
+
+void rgb_matrix_mock_reset(void);
+
+// Seeds both rgb_matrix_rand() and lib8tion so random effects replay identically
+void rgb_matrix_mock_seed(uint16_t seed);
+
+// Time of the last key press as seen by the renderer, see last_input_activity_elapsed()
+extern uint32_t rgb_matrix_mock_input_time;
+
+#ifdef RGB_MATRIX_RENDER_GOVERNOR
+uint8_t rgb_matrix_mock_process_limit(void);
+uint8_t rgb_matrix_mock_flush_limit(void);
+#endif
@@ -0,0 +1,173 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+extern "C" {
+#include "fnv.h"
+#include "rgb_matrix/tests/mock.h"
+
+void rgb_matrix_init(void);
+void rgb_matrix_task(void);
+void rgb_matrix_enable_noeeprom(void);
+void rgb_matrix_disable_noeeprom(void);
+void rgb_matrix_mode_noeeprom(uint8_t mode);
+void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#include "golden_frames.h"
+
+// Keys are hit every few frames, roughly the rate of fast typing
+#define TYPING_FRAME_INTERVAL 4
+// Upper bound on rgb_matrix_task() calls a single frame may take
+#define MAX_TASKS_PER_FRAME 1000
+// Idle time between hits when checking faded hits, long enough for the oldest remembered ones to fade out
+#define FADED_HIT_INTERVAL 250
+
+template <size_t N>
+static const golden_frames_t *find_golden(const golden_frames_t (&table)[N], const char *name) {
+    for (const auto &golden : table) {
+        if (strcmp(golden.name, name) == 0) {
+            return &golden;
+        }
+    }
+    return nullptr;
+}
+
+struct effect_run_t {
+    std::vector<uint32_t> checksums;
+    uint64_t              total_ns;
+    uint32_t              set_color_calls;
+    uint32_t              bytes_flushed;
+};
+
+// Runs rgb_matrix_task() until the next flush, returns the time spent in it
+static uint64_t step_frame(void) {
+    uint32_t flushes = rgb_matrix_mock_stats.flushes;
+    auto     start   = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < MAX_TASKS_PER_FRAME && rgb_matrix_mock_stats.flushes == flushes; i++) {
+        rgb_matrix_task();
+        advance_time(1);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void start_effect(uint8_t mode) {
+    set_time(0);
+    rgb_matrix_mock_seed(1);
+    rgb_matrix_init();
+    // Render one blank frame so the effect always starts from its init pass
+    rgb_matrix_disable_noeeprom();
+    step_frame();
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(mode);
+    rgb_matrix_mock_reset();
+}
+
+static effect_run_t run_effect(uint8_t mode) {
+    effect_run_t run = {};
+
+    start_effect(mode);
+    for (uint16_t frame = 0; frame < GOLDEN_FRAME_COUNT; frame++) {
+        if (frame % TYPING_FRAME_INTERVAL == 0) {
+            uint8_t key = (frame / TYPING_FRAME_INTERVAL) * 7;
+            process_rgb_matrix((key / MATRIX_COLS) % MATRIX_ROWS, key % MATRIX_COLS, true);
+            process_rgb_matrix((key / MATRIX_COLS) % MATRIX_ROWS, key % MATRIX_COLS, false);
+        }
+
+        run.total_ns += step_frame();
+        run.checksums.push_back(fnv_32a_buf(rgb_matrix_mock_pushed, sizeof(rgb_matrix_mock_pushed), FNV1_32A_INIT));
+    }
+
+    run.set_color_calls = rgb_matrix_mock_stats.set_color_calls;
+    run.bytes_flushed   = rgb_matrix_mock_stats.bytes_flushed;
+    return run;
+}
+
+// Hits a key every frame with an idle gap before it, so every frame mixes live and faded hits
+static std::vector<uint32_t> run_faded_hits(uint8_t mode) {
+    std::vector<uint32_t> checksums;
+
+    start_effect(mode);
+    for (uint16_t frame = 0; frame < GOLDEN_FRAME_COUNT; frame++) {
+        uint8_t key = frame * 7;
+        advance_time(FADED_HIT_INTERVAL);
+        process_rgb_matrix((key / MATRIX_COLS) % MATRIX_ROWS, key % MATRIX_COLS, true);
+        process_rgb_matrix((key / MATRIX_COLS) % MATRIX_ROWS, key % MATRIX_COLS, false);
+        step_frame();
+        checksums.push_back(fnv_32a_buf(rgb_matrix_mock_pushed, sizeof(rgb_matrix_mock_pushed), FNV1_32A_INIT));
+    }
+    return checksums;
+}
+
+static std::string format_golden(const char *name, const std::vector<uint32_t> &checksums) {
+    std::stringstream ss;
+    ss << "    {\"" << name << "\", {";
+    for (size_t i = 0; i < checksums.size(); i++) {
+        ss << (i % 8 == 0 ? "\n        " : " ") << "0x" << std::hex << std::setw(8) << std::setfill('0') << checksums[i] << ",";
+    }
+    ss << "\n    }},";
+    return ss.str();
+}
+
+static void expect_golden(const golden_frames_t *golden, const char *name, const std::vector<uint32_t> &checksums) {
+    ASSERT_NE(golden, nullptr) << "No golden frames recorded, add:\n" << format_golden(name, checksums);
+
+    for (uint16_t frame = 0; frame < GOLDEN_FRAME_COUNT; frame++) {
+        if (golden->checksums[frame] != checksums[frame]) {
+            ADD_FAILURE() << "Frame " << frame << " differs from the golden output, if the change is intended replace with:\n" << format_golden(name, checksums);
+            break;
+        }
+    }
+}
+
+class RgbMatrixEffects : public ::testing::TestWithParam<rgb_matrix_mock_effect_t> {};
+
+TEST_P(RgbMatrixEffects, MatchesGoldenFrames) {
+    const rgb_matrix_mock_effect_t &effect = GetParam();
+    effect_run_t                    run    = run_effect(effect.mode);
+
+    printf("[ BENCH    ] %-26s %8llu ns/frame %6u set_color/frame %5u bytes/frame\n", effect.name, (unsigned long long)(run.total_ns / GOLDEN_FRAME_COUNT), run.set_color_calls / GOLDEN_FRAME_COUNT, run.bytes_flushed / GOLDEN_FRAME_COUNT);
+
+    expect_golden(find_golden(golden_frames, effect.name), effect.name, run.checksums);
+}
+
+TEST_P(RgbMatrixEffects, IsDeterministic) {
+    const rgb_matrix_mock_effect_t &effect = GetParam();
+    EXPECT_EQ(run_effect(effect.mode).checksums, run_effect(effect.mode).checksums);
+}
+
+INSTANTIATE_TEST_CASE_P(AllEffects, RgbMatrixEffects, ::testing::ValuesIn(rgb_matrix_mock_effects, rgb_matrix_mock_effects + rgb_matrix_mock_effect_count), [](const ::testing::TestParamInfo<rgb_matrix_mock_effect_t> &info) { return std::string(info.param.name); });
+
+// Effects drawn by effect_runner_reactive_splash(), with or without a horizon
+static std::vector<rgb_matrix_mock_effect_t> splash_effects(void) {
+    static const char *const names[] = {"SOLID_REACTIVE_WIDE", "SOLID_REACTIVE_MULTIWIDE", "SOLID_REACTIVE_CROSS", "SOLID_REACTIVE_MULTICROSS", "SOLID_REACTIVE_NEXUS", "SOLID_REACTIVE_MULTINEXUS", "SPLASH", "MULTISPLASH", "SOLID_SPLASH", "SOLID_MULTISPLASH"};
+
+    std::vector<rgb_matrix_mock_effect_t> effects;
+    for (uint8_t i = 0; i < rgb_matrix_mock_effect_count; i++) {
+        for (const char *name : names) {
+            if (strcmp(rgb_matrix_mock_effects[i].name, name) == 0) {
+                effects.push_back(rgb_matrix_mock_effects[i]);
+            }
+        }
+    }
+    return effects;
+}
+
+class ReactiveSplashHorizon : public ::testing::TestWithParam<rgb_matrix_mock_effect_t> {};
+
+// The goldens are recorded with RGB_MATRIX_REACTIVE_SPLASH_NO_HORIZON, both builds must match them
+TEST_P(ReactiveSplashHorizon, FadedHitsMatchGoldenFrames) {
+    const rgb_matrix_mock_effect_t &effect = GetParam();
+    expect_golden(find_golden(faded_golden_frames, effect.name), effect.name, run_faded_hits(effect.mode));
+}
+
+INSTANTIATE_TEST_CASE_P(SplashEffects, ReactiveSplashHorizon, ::testing::ValuesIn(splash_effects()), [](const ::testing::TestParamInfo<rgb_matrix_mock_effect_t> &info) { return std::string(info.param.name); });
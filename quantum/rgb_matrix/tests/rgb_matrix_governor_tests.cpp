@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix/tests/mock.h"
+
+void rgb_matrix_init(void);
+void rgb_matrix_task(void);
+void rgb_matrix_enable_noeeprom(void);
+void rgb_matrix_mode_noeeprom(uint8_t mode);
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+uint32_t timer_read32(void);
+}
+
+#define FULL_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
+#define FULL_FLUSH_LIMIT 16
+
+class RgbMatrixGovernor : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        rgb_matrix_mock_input_time = 0;
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(rgb_matrix_mock_effects[0].mode);
+    }
+
+    // Runs the renderer for a while, every task taking task_us microseconds of the loop
+    void run(uint32_t ms, uint32_t task_us, bool typing) {
+        uint32_t end = timer_read32() + ms;
+        uint32_t us  = 0;
+        while (timer_read32() < end) {
+            if (typing) {
+                rgb_matrix_mock_input_time = timer_read32();
+            }
+            rgb_matrix_task();
+            us += task_us;
+            advance_time(us / 1000);
+            us %= 1000;
+        }
+    }
+};
+
+TEST_F(RgbMatrixGovernor, KeepsFullQualityWhenLoopIsFast) {
+    run(500, 100, true);
+    EXPECT_EQ(rgb_matrix_mock_process_limit(), FULL_PROCESS_LIMIT);
+    EXPECT_EQ(rgb_matrix_mock_flush_limit(), FULL_FLUSH_LIMIT);
+}
+
+TEST_F(RgbMatrixGovernor, ShrinksBudgetWhileTypingOnSlowLoop) {
+    run(500, 3000, true);
+    EXPECT_EQ(rgb_matrix_mock_process_limit(), 4);
+    EXPECT_EQ(rgb_matrix_mock_flush_limit(), FULL_FLUSH_LIMIT * 4);
+}
+
+TEST_F(RgbMatrixGovernor, KeepsFullQualityOnSlowLoopWhenIdle) {
+    advance_time(2000);
+    run(500, 3000, false);
+    EXPECT_EQ(rgb_matrix_mock_process_limit(), FULL_PROCESS_LIMIT);
+    EXPECT_EQ(rgb_matrix_mock_flush_limit(), FULL_FLUSH_LIMIT);
+}
+
+TEST_F(RgbMatrixGovernor, RestoresFullQualityOnceInputIsQuiet) {
+    run(500, 3000, true);
+    ASSERT_LT(rgb_matrix_mock_process_limit(), FULL_PROCESS_LIMIT);
+    run(1500, 3000, false);
+    EXPECT_EQ(rgb_matrix_mock_process_limit(), FULL_PROCESS_LIMIT);
+    EXPECT_EQ(rgb_matrix_mock_flush_limit(), FULL_FLUSH_LIMIT);
+}
+
+TEST_F(RgbMatrixGovernor, RendersWholeFramesWithShrunkBudget) {
+    run(500, 3000, true);
+    ASSERT_LT(rgb_matrix_mock_process_limit(), FULL_PROCESS_LIMIT);
+
+    // Line up with the end of a frame, then count what the next ones draw
+    uint32_t flushes = rgb_matrix_mock_stats.flushes;
+    while (rgb_matrix_mock_stats.flushes == flushes) {
+        run(1, 3000, true);
+    }
+    rgb_matrix_mock_reset();
+    while (rgb_matrix_mock_stats.flushes < 4) {
+        run(1, 3000, true);
+    }
+    // Every LED is still drawn once per frame, just spread over more tasks
+    EXPECT_EQ(rgb_matrix_mock_stats.set_color_calls, 4u * RGB_MATRIX_LED_COUNT);
+}
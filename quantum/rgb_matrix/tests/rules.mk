@@ -0,0 +1,40 @@
+rgb_matrix_effects_DEFS := -DRGB_MATRIX_ENABLE -DRGB_MATRIX_CUSTOM -DEEPROM_TEST_HARNESS -DNO_DEBUG -DNO_PRINT
+rgb_matrix_effects_CONFIG := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/config_mock.h \
+	$(QUANTUM_PATH)/rgb_matrix/post_config.h
+rgb_matrix_effects_INC := \
+	$(LIB_PATH)/fnv \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations \
+	$(QUANTUM_PATH)/rgb_matrix/animations/runners
+
+rgb_matrix_effects_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(LIB_PATH)/fnv/qmk_fnv_type_validation.c \
+	$(LIB_PATH)/fnv/hash_32a.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/mock.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_effects_tests.cpp
+
+rgb_matrix_effects_lazy_heatmap_DEFS := $(rgb_matrix_effects_DEFS) -DRGB_MATRIX_TYPING_HEATMAP_LAZY_DECAY
+rgb_matrix_effects_lazy_heatmap_CONFIG := $(rgb_matrix_effects_CONFIG)
+rgb_matrix_effects_lazy_heatmap_INC := $(rgb_matrix_effects_INC)
+rgb_matrix_effects_lazy_heatmap_SRC := $(rgb_matrix_effects_SRC)
+
+rgb_matrix_effects_no_horizon_DEFS := $(rgb_matrix_effects_DEFS) -DRGB_MATRIX_REACTIVE_SPLASH_NO_HORIZON
+rgb_matrix_effects_no_horizon_CONFIG := $(rgb_matrix_effects_CONFIG)
+rgb_matrix_effects_no_horizon_INC := $(rgb_matrix_effects_INC)
+rgb_matrix_effects_no_horizon_SRC := $(rgb_matrix_effects_SRC)
+
+rgb_matrix_governor_DEFS := $(rgb_matrix_effects_DEFS) -DRGB_MATRIX_RENDER_GOVERNOR
+rgb_matrix_governor_CONFIG := $(rgb_matrix_effects_CONFIG)
+rgb_matrix_governor_INC := $(rgb_matrix_effects_INC)
+rgb_matrix_governor_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(QUANTUM_PATH)/color.c \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/mock.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_governor_tests.cpp
@@ -0,0 +1,5 @@
+TEST_LIST += \
+	rgb_matrix_effects \
+	rgb_matrix_effects_lazy_heatmap \
+	rgb_matrix_effects_no_horizon \
+	rgb_matrix_governor
@@ -18,10 +18,12 @@
 
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "timer.h"
 #include "wait.h"
 #ifdef LK_WIRELESS_ENABLE
 #include "wireless.h"
@@ -31,6 +33,25 @@
 #endif
 
 
+// Minimum time between reports sent one step at a time, matches the host's polling of the keyboard endpoint
+#ifndef SEND_STRING_REPORT_INTERVAL
+#    ifdef USB_POLLING_INTERVAL_MS
+#        define SEND_STRING_REPORT_INTERVAL USB_POLLING_INTERVAL_MS
+#    else
+#        define SEND_STRING_REPORT_INTERVAL 1
+#    endif
+#endif
+
+// Bytes of queued strings, including their null terminators
+#ifndef SEND_STRING_QUEUE_SIZE
+#    define SEND_STRING_QUEUE_SIZE 128
+#endif
+
+// Number of queued strings
+#ifndef SEND_STRING_QUEUE_ENTRIES
+#    define SEND_STRING_QUEUE_ENTRIES 8
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -242,6 +263,235 @@ void send_char(char ascii_code) {
     }
 }
 
+static inline void send_char_add_step(send_char_steps_t *steps, uint8_t keycode, bool release) {
+    if (release) {
+        steps->release_mask |= 1 << steps->count;
+    }
+    steps->keycodes[steps->count++] = keycode;
+}
+
+void send_char_steps(char ascii_code, send_char_steps_t *steps) {
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    steps->count        = 0;
+    steps->next         = 0;
+    steps->release_mask = 0;
+    if (is_shifted) {
+        send_char_add_step(steps, KC_LEFT_SHIFT, false);
+    }
+    if (is_altgred) {
+        send_char_add_step(steps, KC_RIGHT_ALT, false);
+    }
+    send_char_add_step(steps, keycode, false);
+    send_char_add_step(steps, keycode, true);
+    if (is_altgred) {
+        send_char_add_step(steps, KC_RIGHT_ALT, true);
+    }
+    if (is_shifted) {
+        send_char_add_step(steps, KC_LEFT_SHIFT, true);
+    }
+    if (is_dead) {
+        send_char_add_step(steps, KC_SPACE, false);
+        send_char_add_step(steps, KC_SPACE, true);
+    }
+}
+
+__attribute__((weak)) bool send_string_transport_ready(void) {
+    return true;
+}
+
+bool send_char_steps_next(send_char_steps_t *steps) {
+    static uint32_t last_step = 0;
+
+    if (steps->next >= steps->count || timer_elapsed32(last_step) < SEND_STRING_REPORT_INTERVAL || !send_string_transport_ready()) {
+        return false;
+    }
+
+    uint8_t step = steps->next++;
+    if (steps->release_mask & (1 << step)) {
+        unregister_code(steps->keycodes[step]);
+    } else {
+        register_code(steps->keycodes[step]);
+    }
+    last_step = timer_read32();
+    return true;
+}
+
+typedef struct {
+    send_string_callback_t callback;
+    void *                 context;
+    uint8_t                interval;
+} send_string_entry_t;
+
+static struct {
+    char                buffer[SEND_STRING_QUEUE_SIZE];
+    uint16_t            head; // Next byte to type
+    uint16_t            used;
+    send_string_entry_t entries[SEND_STRING_QUEUE_ENTRIES];
+    uint8_t             entry_head; // String being typed
+    uint8_t             entry_count;
+    send_char_steps_t   steps;       // Keys of the character being typed
+    uint32_t            resume_time; // Nothing is typed before this time
+} send_queue;
+
+static char send_string_queue_pop(void) {
+    char c          = send_queue.buffer[send_queue.head];
+    send_queue.head = (send_queue.head + 1) % SEND_STRING_QUEUE_SIZE;
+    send_queue.used--;
+    return c;
+}
+
+static void send_string_queue_complete(void) {
+    send_string_entry_t entry = send_queue.entries[send_queue.entry_head];
+    send_queue.entry_head     = (send_queue.entry_head + 1) % SEND_STRING_QUEUE_ENTRIES;
+    send_queue.entry_count--;
+    // Dequeued first, so the callback can queue another string
+    if (entry.callback) {
+        entry.callback(entry.context);
+    }
+}
+
+// Decodes the next character or code of the current string, the string's null terminator is always queued so decoding cannot run past it
+static void send_string_queue_decode(void) {
+    uint16_t delay      = send_queue.entries[send_queue.entry_head].interval;
+    char     ascii_code = send_string_queue_pop();
+
+    send_queue.steps.count        = 0;
+    send_queue.steps.next         = 0;
+    send_queue.steps.release_mask = 0;
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = send_string_queue_pop();
+        if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+            uint8_t keycode = send_string_queue_pop();
+            if (keycode == 0) {
+                ascii_code = 0;
+            } else if (ascii_code == SS_TAP_CODE) {
+                // tap
+                send_queue.steps.keycodes[0]  = keycode;
+                send_queue.steps.keycodes[1]  = keycode;
+                send_queue.steps.count        = 2;
+                send_queue.steps.release_mask = 1 << 1;
+            } else {
+                // down or up
+                send_queue.steps.keycodes[0]  = keycode;
+                send_queue.steps.count        = 1;
+                send_queue.steps.release_mask = ascii_code == SS_UP_CODE ? 1 : 0;
+            }
+        } else if (ascii_code == SS_DELAY_CODE) {
+            // delay, the character ending the number is skipped
+            uint16_t ms = 0;
+            ascii_code  = send_string_queue_pop();
+            while (isdigit(ascii_code)) {
+                ms *= 10;
+                ms += ascii_code - '0';
+                ascii_code = send_string_queue_pop();
+            }
+            delay += ms;
+        }
+    } else if (ascii_code != 0) {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        if (ascii_code == '\a') {
+            send_char(ascii_code);
+        } else
+#endif
+        {
+            send_char_steps(ascii_code, &send_queue.steps);
+        }
+    }
+
+    if (ascii_code == 0) {
+        send_string_queue_complete();
+        return;
+    }
+    // Keys are typed first, then the delay applies
+    send_queue.resume_time = timer_read32() + (send_queue.steps.count > 0 ? 0 : delay);
+}
+
+void send_string_async_task(void) {
+    if (send_queue.steps.next < send_queue.steps.count) {
+        if (send_char_steps_next(&send_queue.steps) && send_queue.steps.next == send_queue.steps.count) {
+            send_queue.resume_time = timer_read32() + send_queue.entries[send_queue.entry_head].interval;
+        }
+        return;
+    }
+    if (send_queue.entry_count > 0 && timer_expired32(timer_read32(), send_queue.resume_time)) {
+        send_string_queue_decode();
+    }
+}
+
+bool send_string_is_busy(void) {
+    return send_queue.entry_count > 0 || send_queue.steps.next < send_queue.steps.count;
+}
+
+static void send_string_queue_wait(void) {
+#if defined(LK_WIRELESS_ENABLE) || defined(KC_BLUETOOTH_ENABLE)
+    send_string_task();
+#endif
+    send_string_async_task();
+    wait_ms(1);
+}
+
+bool send_string_enqueue(const char *string, uint8_t interval, uint8_t flags, send_string_callback_t callback, void *context) {
+    bool     progmem  = flags & SEND_STRING_FLAG_PROGMEM;
+    bool     blocking = flags & SEND_STRING_FLAG_BLOCKING;
+    uint16_t length   = (progmem ? strlen_P(string) : strlen(string)) + 1;
+
+    if (length > SEND_STRING_QUEUE_SIZE) {
+        if (!blocking) {
+            return false;
+        }
+        // Too long to ever fit, type it in place once everything before it has been typed
+        while (send_string_is_busy()) {
+            send_string_queue_wait();
+        }
+        if (progmem) {
+            send_string_with_delay_P(string, interval);
+        } else {
+            send_string_with_delay(string, interval);
+        }
+        if (callback) {
+            callback(context);
+        }
+        return true;
+    }
+
+    while (SEND_STRING_QUEUE_SIZE - send_queue.used < length || send_queue.entry_count == SEND_STRING_QUEUE_ENTRIES) {
+        if (!blocking) {
+            return false;
+        }
+        send_string_queue_wait();
+    }
+
+    if (!send_string_is_busy()) {
+        send_queue.resume_time = timer_read32();
+    }
+
+    uint16_t tail = (send_queue.head + send_queue.used) % SEND_STRING_QUEUE_SIZE;
+    for (uint16_t i = 0; i < length; i++) {
+        send_queue.buffer[tail] = progmem ? pgm_read_byte(&string[i]) : string[i];
+        tail                    = (tail + 1) % SEND_STRING_QUEUE_SIZE;
+    }
+    send_queue.used += length;
+
+    send_queue.entries[(send_queue.entry_head + send_queue.entry_count) % SEND_STRING_QUEUE_ENTRIES] = (send_string_entry_t){
+        .callback = callback,
+        .context  = context,
+        .interval = interval,
+    };
+    send_queue.entry_count++;
+
+    if (blocking) {
+        while (send_string_is_busy()) {
+            send_string_queue_wait();
+        }
+    }
+    return true;
+}
+
 void send_dword(uint32_t number) {
     send_word(number >> 16);
     send_word(number & 0xFFFFUL);
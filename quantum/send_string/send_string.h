@@ -23,7 +23,11 @@
  * \{
  */
 
+#pragma once
+
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -72,6 +76,89 @@ void send_string_with_delay(const char *string, uint8_t interval);
  */
 void send_char(char ascii_code);
 
+/**
+ * \brief The most key presses and releases send_char() makes for a single character.
+ */
+#define SEND_CHAR_MAX_STEPS 8
+
+/**
+ * \brief The key presses and releases making up a single character, in order.
+ */
+typedef struct {
+    uint8_t count;
+    uint8_t next;         // Index of the next step to send
+    uint8_t release_mask; // Bit n is set when step n releases keycodes[n] rather than pressing it
+    uint8_t keycodes[SEND_CHAR_MAX_STEPS];
+} send_char_steps_t;
+
+/**
+ * \brief Break an ASCII character down into the key presses and releases send_char() would make.
+ *
+ * This allows a character to be typed one report at a time from a task, rather than all at once.
+ *
+ * \param ascii_code The character to type.
+ * \param steps The steps making up the character.
+ */
+void send_char_steps(char ascii_code, send_char_steps_t *steps);
+
+/**
+ * \brief Whether the host transport can accept another report without queueing or blocking.
+ *
+ * Non-blocking senders check this before each report. The default implementation always returns true, transports with their own report queue should override it.
+ *
+ * \return `true` if the next report can be sent now.
+ */
+bool send_string_transport_ready(void);
+
+/**
+ * \brief Send the next key press or release of a character, if the transport can take it.
+ *
+ * Steps are spaced at least `SEND_STRING_REPORT_INTERVAL` milliseconds apart, and held back while send_string_transport_ready() returns false.
+ *
+ * \param steps The character being typed.
+ * \return `true` if a step was sent.
+ */
+bool send_char_steps_next(send_char_steps_t *steps);
+
+/**
+ * \brief Flags for send_string_enqueue().
+ */
+enum send_string_flags_t {
+    SEND_STRING_FLAG_PROGMEM  = (1 << 0), ///< The string is stored in PROGMEM
+    SEND_STRING_FLAG_BLOCKING = (1 << 1), ///< Return only once the string has been typed
+};
+
+/**
+ * \brief Called once a queued string has been typed out.
+ */
+typedef void (*send_string_callback_t)(void *context);
+
+/**
+ * \brief Queue a string to be typed out from the main loop.
+ *
+ * The string is copied into a ring of `SEND_STRING_QUEUE_SIZE` bytes, and typed by send_string_async_task() one report at a time. Strings are typed in the order they were queued.
+ *
+ * With `SEND_STRING_FLAG_BLOCKING`, this waits for room in the queue and returns once the string has been typed, like send_string_with_delay().
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \param flags A combination of `send_string_flags_t`.
+ * \param callback Called once the string has been typed, may be `NULL`.
+ * \param context Passed to the callback.
+ * \return `false` if the string did not fit in the queue and was dropped.
+ */
+bool send_string_enqueue(const char *string, uint8_t interval, uint8_t flags, send_string_callback_t callback, void *context);
+
+/**
+ * \brief Whether any queued strings have yet to be typed out.
+ */
+bool send_string_is_busy(void);
+
+/**
+ * \brief Type out queued strings. Called from the main loop.
+ */
+void send_string_async_task(void);
+
 /**
  * \brief Type out an eight digit (unsigned 32-bit) hexadecimal value.
  *
@@ -151,4 +238,11 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+/**
+ * \brief Shortcut macro for send_string_enqueue(PSTR(string), 0, SEND_STRING_FLAG_PROGMEM, NULL, NULL).
+ *
+ * Queues the string and returns immediately.
+ */
+#define SEND_STRING_ASYNC(string) send_string_enqueue(PSTR(string), 0, SEND_STRING_FLAG_PROGMEM, NULL, NULL)
+
 /** \} */
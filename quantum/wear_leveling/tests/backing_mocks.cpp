@@ -20,15 +20,17 @@ void MockBackingStore::reset_instance() {
 
     backing_init_invoke_count   = 0;
     backing_unlock_invoke_count = 0;
-    backing_erase_invoke_count  = 0;
-    backing_write_invoke_count  = 0;
-    backing_lock_invoke_count   = 0;
-
-    init_success_callback   = [](std::uint64_t) { return true; };
-    erase_success_callback  = [](std::uint64_t) { return true; };
-    unlock_success_callback = [](std::uint64_t) { return true; };
-    write_success_callback  = [](std::uint64_t, std::uint32_t) { return true; };
-    lock_success_callback   = [](std::uint64_t) { return true; };
+    backing_erase_invoke_count      = 0;
+    backing_erase_bank_invoke_count = 0;
+    backing_write_invoke_count      = 0;
+    backing_lock_invoke_count       = 0;
+
+    init_success_callback       = [](std::uint64_t) { return true; };
+    erase_success_callback      = [](std::uint64_t) { return true; };
+    erase_bank_success_callback = [](std::uint64_t, std::uint8_t) { return true; };
+    unlock_success_callback     = [](std::uint64_t) { return true; };
+    write_success_callback      = [](std::uint64_t, std::uint32_t) { return true; };
+    lock_success_callback       = [](std::uint64_t) { return true; };
 
     write_log.clear();
 }
@@ -75,6 +77,25 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+bool MockBackingStore::erase_bank(std::uint8_t bank) {
+    ++backing_erase_bank_invoke_count;
+
+    EXPECT_TRUE(bank < 2) << "Attempted to erase a bank which does not exist";
+
+    // Erase each slot in the bank
+    const std::size_t bank_elements = backing_storage.size() / 2;
+    for (std::size_t i = bank * bank_elements; i < (bank + 1) * bank_elements; ++i) {
+        // Drop out of erase early with failure if we need to, leaving the bank partially erased
+        if (erase_bank_success_callback && !erase_bank_success_callback(backing_erase_bank_invoke_count, bank)) {
+            return false;
+        }
+
+        backing_storage[i].erase();
+    }
+
+    return true;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -141,6 +162,10 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" bool backing_store_erase_bank(uint8_t bank) {
+    return MockBackingStore::Instance().erase_bank(bank);
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -12,6 +12,7 @@ wear_leveling_common_INC := \
 
 wear_leveling_general_DEFS := \
 	$(wear_leveling_common_DEFS) \
+	-DEEPROM_STATS_ENABLE \
 	-DBACKING_STORE_WRITE_SIZE=2 \
 	-DWEAR_LEVELING_BACKING_SIZE=48 \
 	-DWEAR_LEVELING_LOGICAL_SIZE=16
@@ -63,4 +64,17 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+wear_leveling_background_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DEEPROM_STATS_ENABLE \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=128 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_BACKGROUND_CONSOLIDATION \
+	-DWEAR_LEVELING_BACKGROUND_STEP_SIZE=4
+wear_leveling_background_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_background.cpp
+wear_leveling_background_INC := \
+	$(wear_leveling_common_INC)
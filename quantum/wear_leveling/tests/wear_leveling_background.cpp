@@ -0,0 +1,260 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Erase, one step per WEAR_LEVELING_BACKGROUND_STEP_SIZE bytes of logical data, then seal
+#define BACKGROUND_STEP_COUNT (1 + (WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_BACKGROUND_STEP_SIZE) + 1)
+// Single byte writes below address 64 each take one 2-byte log entry
+#define WRITES_TO_THRESHOLD (WEAR_LEVELING_BACKGROUND_THRESHOLD / BACKING_STORE_WRITE_SIZE)
+
+class WearLevelingBackground : public ::testing::Test {
+   protected:
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected;
+    std::uint8_t                                         next_value;
+
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+        next_value = 0x20;
+    }
+
+    void write_byte(std::uint32_t address) {
+        std::uint8_t value = next_value++;
+        EXPECT_NE(wear_leveling_write(address, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write should have succeeded";
+        expected[address] = value;
+    }
+
+    void write_until_threshold() {
+        for (int i = 0; i < WRITES_TO_THRESHOLD; ++i) {
+            write_byte(i % WEAR_LEVELING_LOGICAL_SIZE);
+        }
+    }
+
+    void verify_after_reinit(const char* context) {
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init failed: " << context;
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read: " << context;
+        EXPECT_EQ(actual, expected) << "Invalid readback: " << context;
+    }
+};
+
+/**
+ * This test verifies that a clean backing store gets a valid bank on first init, which is then reused.
+ */
+TEST_F(WearLevelingBackground, CleanInit_SealsBankOnce) {
+    auto& inst = MockBackingStore::Instance();
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should not have been erased";
+    EXPECT_EQ(inst.erase_bank_invoke_count(), 1) << "Spare bank should have been erased once";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-init should find a valid bank";
+    EXPECT_EQ(inst.erase_bank_invoke_count(), 1) << "Re-init should not erase";
+}
+
+/**
+ * This test verifies that nothing happens in the background until the write log passes the threshold.
+ */
+TEST_F(WearLevelingBackground, Task_IdleBelowThreshold) {
+    auto& inst        = MockBackingStore::Instance();
+    auto  erase_count = inst.erase_bank_invoke_count();
+
+    for (int i = 0; i < WRITES_TO_THRESHOLD - 1; ++i) {
+        write_byte(i);
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should have been idle";
+    }
+    EXPECT_EQ(inst.erase_bank_invoke_count(), erase_count) << "Task should not have erased below the threshold";
+}
+
+/**
+ * This test verifies that consolidation completes in bounded steps without the writes themselves erasing anything.
+ */
+TEST_F(WearLevelingBackground, Task_ConsolidatesInSteps) {
+    auto& inst        = MockBackingStore::Instance();
+    auto  erase_count = inst.erase_bank_invoke_count();
+
+    write_until_threshold();
+    EXPECT_EQ(inst.erase_bank_invoke_count(), erase_count) << "Writes should not have erased";
+
+    int steps = 0;
+    while (wear_leveling_task() == WEAR_LEVELING_SUCCESS && steps < 100) {
+        ++steps;
+    }
+    EXPECT_EQ(steps + 1, BACKGROUND_STEP_COUNT) << "Unexpected number of steps";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should not have been erased";
+    EXPECT_EQ(inst.erase_bank_invoke_count(), erase_count + 1) << "Spare bank should have been erased once";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should be idle after switching over";
+
+    verify_after_reinit("after consolidation");
+}
+
+/**
+ * This test verifies that background consolidation is counted once, along with its bank erasure.
+ */
+TEST_F(WearLevelingBackground, Stats_CountBackgroundConsolidation) {
+    const wear_leveling_stats_t* stats          = wear_leveling_get_stats();
+    auto                         consolidations = stats->consolidations;
+    auto                         erases         = stats->erases;
+
+    write_until_threshold();
+    EXPECT_EQ(stats->appends, WRITES_TO_THRESHOLD) << "Each single byte write should be one log entry";
+
+    while (wear_leveling_task() == WEAR_LEVELING_SUCCESS) {
+    }
+    EXPECT_EQ(stats->consolidations, consolidations + 1) << "Consolidation should have been counted once";
+    EXPECT_EQ(stats->erases, erases + 1) << "Spare bank erasure should have been counted";
+}
+
+/**
+ * This test verifies that writes landing in already-copied data during a consolidation are carried across.
+ */
+TEST_F(WearLevelingBackground, WritesDuringCopy_Replayed) {
+    write_until_threshold();
+
+    // Erase, then copy the first step
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+
+    write_byte(0x01);                                           // already copied
+    write_byte(WEAR_LEVELING_LOGICAL_SIZE - 1);                 // not yet copied
+    write_byte(WEAR_LEVELING_BACKGROUND_STEP_SIZE - 1);         // already copied, widens the range
+
+    wear_leveling_status_t status;
+    int                    steps = 0;
+    while ((status = wear_leveling_task()) == WEAR_LEVELING_SUCCESS && steps < 100) {
+        ++steps;
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation should have completed";
+
+    verify_after_reinit("after consolidation with concurrent writes");
+}
+
+/**
+ * This test verifies that filling the write log mid-consolidation finishes the consolidation in-line, without erasing the whole backing store.
+ */
+TEST_F(WearLevelingBackground, LogFullDuringCopy_FinishesInline) {
+    auto& inst        = MockBackingStore::Instance();
+    auto  erase_count = inst.erase_bank_invoke_count();
+
+    write_until_threshold();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+
+    // Keep writing without running the task until the log overflows
+    for (int i = 0; i < WRITES_TO_THRESHOLD * 2; ++i) {
+        write_byte((i * 3) % WEAR_LEVELING_LOGICAL_SIZE);
+    }
+
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Whole backing store should not have been erased";
+    EXPECT_GT(inst.erase_bank_invoke_count(), erase_count) << "Consolidation should have completed in-line";
+
+    verify_after_reinit("after in-line consolidation");
+}
+
+/**
+ * This test verifies that without single bank erasure, a full write log falls back to erasing the whole backing store.
+ */
+TEST_F(WearLevelingBackground, EraseBankUnsupported_FallsBackToSynchronous) {
+    auto& inst = MockBackingStore::Instance();
+    inst.set_erase_bank_callback([](std::uint64_t, std::uint8_t) { return false; });
+
+    write_until_threshold();
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Bank erase should have failed";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should not retry once bank erase has failed";
+
+    for (int i = 0; i < WRITES_TO_THRESHOLD * 2; ++i) {
+        write_byte(i % WEAR_LEVELING_LOGICAL_SIZE);
+    }
+    EXPECT_EQ(inst.erase_invoke_count(), 1) << "Whole backing store should have been erased once";
+
+    inst.set_erase_bank_callback([](std::uint64_t, std::uint8_t) { return true; });
+    verify_after_reinit("after synchronous consolidation");
+}
+
+/**
+ * This test verifies that losing power between any two background steps, with writes interleaved, loses no data.
+ */
+TEST_F(WearLevelingBackground, PowerLoss_BetweenSteps) {
+    for (int k = 0; k <= BACKGROUND_STEP_COUNT; ++k) {
+        SetUp();
+        write_until_threshold();
+        for (int step = 0; step < k; ++step) {
+            wear_leveling_task();
+            write_byte((step * 5) % WEAR_LEVELING_LOGICAL_SIZE);
+        }
+
+        // Power loss
+        std::string context = "power loss after step " + std::to_string(k);
+        verify_after_reinit(context.c_str());
+
+        // Writes must continue to persist
+        write_byte(0x03);
+        verify_after_reinit((context + ", subsequent write").c_str());
+    }
+}
+
+/**
+ * This test verifies that losing power part-way through any single backing store write of the consolidation loses no data.
+ */
+TEST_F(WearLevelingBackground, PowerLoss_DuringWrite) {
+    auto& inst = MockBackingStore::Instance();
+    for (std::uint64_t n = 0; n < 1000; ++n) {
+        SetUp();
+        write_until_threshold();
+        write_byte(0x02);
+
+        // Fail every backing store write after the first n, emulating the power going away
+        std::uint64_t base = inst.write_invoke_count();
+        inst.set_write_callback([base, n](std::uint64_t count, std::uint32_t) { return count <= base + n; });
+
+        wear_leveling_status_t status;
+        int                    steps = 0;
+        while ((status = wear_leveling_task()) == WEAR_LEVELING_SUCCESS && steps < 100) {
+            ++steps;
+        }
+
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        std::string context = "power loss after " + std::to_string(n) + " writes";
+        verify_after_reinit(context.c_str());
+
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            // Consolidation needed fewer writes than we allowed, every write has been covered
+            break;
+        }
+    }
+}
+
+/**
+ * This test verifies that losing power part-way through erasing the spare bank loses no data.
+ */
+TEST_F(WearLevelingBackground, PowerLoss_DuringErase) {
+    auto& inst = MockBackingStore::Instance();
+    for (std::uint64_t n = 0; n < (WEAR_LEVELING_BANK_SIZE / BACKING_STORE_WRITE_SIZE); ++n) {
+        SetUp();
+        write_until_threshold();
+
+        // Fail the erase after n elements
+        std::uint64_t elements = 0;
+        inst.set_erase_bank_callback([&elements, n](std::uint64_t, std::uint8_t) { return elements++ < n; });
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Bank erase should have failed";
+
+        inst.set_erase_bank_callback([](std::uint64_t, std::uint8_t) { return true; });
+        std::string context = "power loss after erasing " + std::to_string(n) + " elements";
+        verify_after_reinit(context.c_str());
+    }
+}
+
+/**
+ * This test verifies that the newest bank is selected when both banks are valid.
+ */
+TEST_F(WearLevelingBackground, BothBanksValid_NewestSelected) {
+    for (int round = 0; round < 4; ++round) {
+        write_until_threshold();
+        while (wear_leveling_task() == WEAR_LEVELING_SUCCESS) {
+        }
+        // The previous bank remains valid until the next consolidation erases it
+        verify_after_reinit(("round " + std::to_string(round)).c_str());
+    }
+}
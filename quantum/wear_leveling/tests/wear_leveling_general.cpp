@@ -202,3 +202,102 @@ TEST_F(WearLevelingGeneral, WriteFailure_NoSubsequentWrites) {
     wear_leveling_read(0x04, &test_val, sizeof(test_val));
     EXPECT_EQ(test_val, 0x14) << "Readback should come from cache regardless of unlock failure";
 }
+
+/**
+ * This test verifies that cached writes do not touch the backing store until committed, and that a batched commit unlocks the backing store only once.
+ */
+TEST_F(WearLevelingGeneral, CachedWrite_DeferredUntilCommit) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write_cached(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "First cached write should have succeeded";
+    test_val = 0x15;
+    EXPECT_EQ(wear_leveling_write_cached(0x05, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Second cached write should have succeeded";
+
+    EXPECT_EQ(inst.unlock_invoke_count(), 0) << "Unlock should not have been invoked";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have been invoked";
+
+    test_val = 0;
+    wear_leveling_read(0x02, &test_val, sizeof(test_val));
+    EXPECT_EQ(test_val, 0x14) << "Readback should come from cache before commit";
+
+    const wear_leveling_range_t ranges[] = {{0x02, 1}, {0x05, 1}};
+    EXPECT_EQ(wear_leveling_commit(ranges, 2), WEAR_LEVELING_SUCCESS) << "Commit should have succeeded";
+
+    EXPECT_EQ(inst.unlock_invoke_count(), 1) << "Unlock should have been invoked once";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Erase should not have been invoked";
+    EXPECT_EQ(inst.write_invoke_count(), 2) << "Write should have been invoked once per range";
+    EXPECT_EQ(inst.lock_invoke_count(), 1) << "Lock should have been invoked once";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    wear_leveling_read(0x02, &test_val, sizeof(test_val));
+    EXPECT_EQ(test_val, 0x14) << "Committed value should survive re-init";
+    wear_leveling_read(0x05, &test_val, sizeof(test_val));
+    EXPECT_EQ(test_val, 0x15) << "Committed value should survive re-init";
+}
+
+/**
+ * This test verifies that uncommitted cached writes are discarded on re-init.
+ */
+TEST_F(WearLevelingGeneral, CachedWrite_LostWithoutCommit) {
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write_cached(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Cached write should have succeeded";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    wear_leveling_read(0x02, &test_val, sizeof(test_val));
+    EXPECT_EQ(test_val, 0x00) << "Uncommitted value should not survive re-init";
+}
+
+/**
+ * This test verifies that if a commit fills the write log, consolidation persists the ranges that were not yet appended.
+ */
+TEST_F(WearLevelingGeneral, Commit_ConsolidationPersistsRemainingRanges) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(wear_leveling_write_cached(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Cached write should have succeeded";
+
+    const wear_leveling_range_t ranges[] = {{0, WEAR_LEVELING_LOGICAL_SIZE / 2}, {WEAR_LEVELING_LOGICAL_SIZE / 2, WEAR_LEVELING_LOGICAL_SIZE / 2}};
+    EXPECT_EQ(wear_leveling_commit(ranges, 2), WEAR_LEVELING_CONSOLIDATED) << "Commit should have consolidated";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Backing store should have been erased once";
+
+    std::fill(testvalue.begin(), testvalue.end(), 0);
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+        EXPECT_EQ(testvalue[i], 0x20 + i) << "Invalid readback";
+    }
+}
+
+/**
+ * This test verifies that log appends, consolidations and erasures are counted.
+ */
+TEST_F(WearLevelingGeneral, Stats_CountBackingStoreActivity) {
+    auto& inst = MockBackingStore::Instance();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    const wear_leveling_stats_t* stats = wear_leveling_get_stats();
+    EXPECT_EQ(stats->appends, 0) << "Counters should start from zero after init";
+    EXPECT_EQ(stats->consolidations, 0) << "Counters should start from zero after init";
+    EXPECT_EQ(stats->erases, 0) << "Counters should start from zero after init";
+
+    uint8_t test_val = 0x14;
+    EXPECT_EQ(wear_leveling_write(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(wear_leveling_write(0x02, &test_val, sizeof(test_val)), WEAR_LEVELING_SUCCESS) << "Write should have succeeded";
+    EXPECT_EQ(stats->appends, 1) << "Unchanged data should not be appended";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(wear_leveling_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_CONSOLIDATED) << "Write should have consolidated";
+    EXPECT_EQ(stats->consolidations, 1) << "Consolidation should have been counted";
+    EXPECT_EQ(stats->erases, inst.erasure_count()) << "Erasures should match the backing store";
+    EXPECT_GT(stats->appends, 1) << "Log entries before the consolidation should have been counted";
+
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase should have succeeded";
+    EXPECT_EQ(stats->erases, inst.erasure_count()) << "Erasures should match the backing store";
+
+    wear_leveling_reset_stats();
+    EXPECT_EQ(stats->appends, 0) << "Counters should be cleared by a reset";
+    EXPECT_EQ(stats->consolidations, 0) << "Counters should be cleared by a reset";
+    EXPECT_EQ(stats->erases, 0) << "Counters should be cleared by a reset";
+}
@@ -61,6 +61,11 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_BACKGROUND_CONSOLIDATION: Splits the backing store into
+            two banks so that consolidation can occur in the background, see
+            below. The backing size must be at least four times the logical
+            size.
+
     General algorithm:
 
         During initialization:
@@ -76,6 +81,29 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+    Background consolidation:
+
+        With WEAR_LEVELING_BACKGROUND_CONSOLIDATION the backing store is split
+        into two equally-sized banks. Each bank holds consolidated data, the
+        FNV1a_64 of that data and a generation counter, followed by its own
+        write log. During initialization the bank with a valid checksum and the
+        newest generation is used.
+
+        Once the active bank's write log passes a threshold, wear_leveling_task()
+        moves the cache across to the spare bank in bounded steps:
+            * The spare bank is erased.
+            * The cache is copied to the spare bank a few bytes at a time.
+                Writes continue to be appended to the active bank's log, any
+                landing in already-copied data are remembered.
+            * Remembered writes are appended to the spare bank's log, followed
+                by the generation and finally the checksum. Writing the checksum
+                is the switch-over point -- a power loss before it leaves the
+                previous bank in use, along with its complete write log.
+
+        If the write log fills before this completes, the remaining steps are
+        executed in-line. If the backing store is unable to erase a single bank,
+        the whole backing store is erased and consolidated as described above.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -162,8 +190,42 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    uint32_t bank_base;
+    uint32_t generation;
+    struct {
+        uint8_t  state;
+        bool     unsupported;
+        uint32_t copy_offset;
+        uint64_t copy_hash;
+        uint32_t dirty_start;
+        uint32_t dirty_end;
+    } background;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+#ifdef EEPROM_STATS_ENABLE
+    wear_leveling_stats_t stats;
+#endif // EEPROM_STATS_ENABLE
 } wear_leveling;
 
+#ifdef EEPROM_STATS_ENABLE
+#    define wl_count(counter) (wear_leveling.stats.counter++)
+#else
+#    define wl_count(counter)
+#endif // EEPROM_STATS_ENABLE
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+#    define WEAR_LEVELING_BANK_BASE (wear_leveling.bank_base)
+
+/**
+ * Background consolidation state.
+ */
+enum { BACKGROUND_IDLE, BACKGROUND_ERASE, BACKGROUND_COPY, BACKGROUND_SEAL };
+
+static wear_leveling_status_t wear_leveling_background_finish(void);
+#else
+#    define WEAR_LEVELING_BANK_BASE 0
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -202,9 +264,36 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOG_OFFSET); // skips the FNV1a_64 of the consolidated buffer, and the generation if banked
 }
 
+/**
+ * Writes a single 8-byte entry, such as the FNV1a_64 of the consolidated area.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+/**
+ * Reads a single 8-byte entry, such as the FNV1a_64 of the consolidated area.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
+}
+
+#ifndef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -223,13 +312,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_entry((WEAR_LEVELING_LOGICAL_SIZE), &entry);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
@@ -247,6 +330,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 
     return status;
 }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
@@ -258,7 +342,7 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     wear_leveling_status_t      status      = WEAR_LEVELING_CONSOLIDATED;
-    if (!backing_store_write_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_write_bulk(WEAR_LEVELING_BANK_BASE, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to write to backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
@@ -267,25 +351,20 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
         // Write out the FNV1a_64 result of the consolidated data
         write_log_entry_t entry;
         entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+        // The generation is covered by the checksum, and written before it so that the checksum remains the switch-over point
+        write_log_entry_t generation = {.raw64 = 0};
+        generation.raw32[0]          = wear_leveling.generation;
+        entry.raw64                  = fnv_64a_buf(&generation.raw32[0], sizeof(uint32_t), entry.raw64);
+        wl_dprintf("Writing generation\n");
+        if (!wear_leveling_write_entry(WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &generation)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (status != WEAR_LEVELING_FAILED && !wear_leveling_write_entry(WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -300,6 +379,18 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
  * During this operation, there is the potential for data loss if a power loss occurs.
  */
 static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Prefer finishing the consolidation into the spare bank, which never leaves the backing store without valid data
+    if (wear_leveling_background_finish() == WEAR_LEVELING_CONSOLIDATED) {
+        return WEAR_LEVELING_CONSOLIDATED;
+    }
+
+    // Last resort, start over from the first bank
+    wear_leveling.background.state = BACKGROUND_IDLE;
+    wear_leveling.bank_base        = 0;
+    wear_leveling.generation++;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     wl_dprintf("Erasing backing store\n");
 
     // Erase the backing store. Expectation is that any un-written values that are read back after this call come back as zero.
@@ -308,15 +399,18 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
         wl_dprintf("Failed to erase backing store\n");
         return WEAR_LEVELING_FAILED;
     }
+    wl_count(erases);
 
     // Write the cache to the first section of the backing store.
     wear_leveling_status_t status = wear_leveling_write_consolidated();
     if (status == WEAR_LEVELING_FAILED) {
         wl_dprintf("Failed to write consolidated data\n");
+    } else {
+        wl_count(consolidations);
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOG_OFFSET);
 
     return status;
 }
@@ -329,7 +423,13 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // While sealing, the spare bank's log is being written and has already been checked for space
+    if (wear_leveling.background.state == BACKGROUND_SEAL) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    if (wear_leveling.write_address >= WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_BANK_SIZE)) {
         return wear_leveling_consolidate_force();
     }
 
@@ -348,6 +448,7 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
         return WEAR_LEVELING_FAILED;
     }
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+    wl_count(appends);
     return wear_leveling_consolidate_if_needed();
 }
 
@@ -477,8 +578,8 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOG_OFFSET);
+    while (!cancel_playback && address < WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -611,12 +712,254 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     return status;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Checks whether the bank at the supplied address holds consolidated data matching its checksum.
+ */
+static bool wear_leveling_bank_valid(uint32_t bank_base, uint32_t *generation) {
+    backing_store_int_t chunk[8];
+    uint64_t            hash = FNV1A_64_INIT;
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_LOGICAL_SIZE); offset += sizeof(chunk)) {
+        const uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE)-offset < sizeof(chunk) ? (WEAR_LEVELING_LOGICAL_SIZE)-offset : sizeof(chunk);
+        if (!backing_store_read_bulk(bank_base + offset, chunk, length / sizeof(backing_store_int_t))) {
+            return false;
+        }
+        hash = fnv_64a_buf(chunk, length, hash);
+    }
+
+    write_log_entry_t gen;
+    write_log_entry_t checksum;
+    if (!wear_leveling_read_entry(bank_base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &gen) || !wear_leveling_read_entry(bank_base + (WEAR_LEVELING_LOGICAL_SIZE), &checksum)) {
+        return false;
+    }
+    *generation = gen.raw32[0];
+    return checksum.raw64 == fnv_64a_buf(&gen.raw32[0], sizeof(uint32_t), hash);
+}
+
+/**
+ * Selects the valid bank with the newest generation.
+ *
+ * @return false if neither bank is valid
+ */
+static bool wear_leveling_select_bank(void) {
+    uint32_t   gen0, gen1;
+    const bool valid0 = wear_leveling_bank_valid(0, &gen0);
+    const bool valid1 = wear_leveling_bank_valid((WEAR_LEVELING_BANK_SIZE), &gen1);
+    if (!valid0 && !valid1) {
+        return false;
+    }
+
+    // Generations may wrap, so compare using the signed difference
+    if (valid0 && (!valid1 || (int32_t)(gen0 - gen1) > 0)) {
+        wear_leveling.bank_base  = 0;
+        wear_leveling.generation = gen0;
+    } else {
+        wear_leveling.bank_base  = (WEAR_LEVELING_BANK_SIZE);
+        wear_leveling.generation = gen1;
+    }
+    wl_dprintf("Selected bank %d, generation %lu\n", (int)(wear_leveling.bank_base / (WEAR_LEVELING_BANK_SIZE)), (unsigned long)wear_leveling.generation);
+    return true;
+}
+
+/**
+ * Records cache modifications that the in-progress copy has already passed, so they can be replayed into the spare bank.
+ */
+static void wear_leveling_background_touch(uint32_t address, size_t length) {
+    if (wear_leveling.background.state < BACKGROUND_COPY || address >= wear_leveling.background.copy_offset) {
+        return;
+    }
+
+    uint32_t end = address + length;
+    if (end > wear_leveling.background.copy_offset) {
+        end = wear_leveling.background.copy_offset;
+    }
+    if (address < wear_leveling.background.dirty_start) {
+        wear_leveling.background.dirty_start = address;
+    }
+    if (end > wear_leveling.background.dirty_end) {
+        wear_leveling.background.dirty_end = end;
+    }
+}
+
+/**
+ * Final background step: replays writes made during the copy, then writes the generation and checksum of the spare bank.
+ */
+static wear_leveling_status_t wear_leveling_background_seal(uint32_t spare_base) {
+    const uint32_t dirty_length = wear_leveling.background.dirty_end > wear_leveling.background.dirty_start ? wear_leveling.background.dirty_end - wear_leveling.background.dirty_start : 0;
+
+    // Each logical byte needs at most two bytes of write log, plus a partial entry. If replaying would use more than
+    // half of the spare bank's write log then copy everything again instead.
+    if (dirty_length * 2 + 8 > ((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET)) / 2) {
+        wl_dprintf("Background: too many writes during copy, restarting\n");
+        wear_leveling.background.state = BACKGROUND_ERASE;
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    const uint32_t         active_write_address = wear_leveling.write_address;
+    wear_leveling_status_t status               = WEAR_LEVELING_SUCCESS;
+    wear_leveling.write_address                 = spare_base + (WEAR_LEVELING_LOG_OFFSET);
+    if (dirty_length > 0) {
+        wl_dprintf("Background: replaying writes made during copy\n");
+        status = wear_leveling_write_raw(wear_leveling.background.dirty_start, &wear_leveling.cache[wear_leveling.background.dirty_start], dirty_length);
+    }
+
+    write_log_entry_t generation = {.raw64 = 0};
+    generation.raw32[0]          = wear_leveling.generation + 1;
+    write_log_entry_t checksum   = {.raw64 = fnv_64a_buf(&generation.raw32[0], sizeof(uint32_t), wear_leveling.background.copy_hash)};
+    if (status == WEAR_LEVELING_SUCCESS) {
+        wl_dprintf("Background: writing generation and checksum\n");
+        if (!wear_leveling_write_entry(spare_base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &generation) || !wear_leveling_write_entry(spare_base + (WEAR_LEVELING_LOGICAL_SIZE), &checksum)) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    if (status != WEAR_LEVELING_SUCCESS) {
+        // The active bank and its write log are untouched, carry on using them
+        wl_dprintf("Background: failed to seal spare bank\n");
+        wear_leveling.write_address    = active_write_address;
+        wear_leveling.background.state = BACKGROUND_IDLE;
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Switched over -- the previous bank is erased once the next consolidation starts
+    wear_leveling.bank_base        = spare_base;
+    wear_leveling.generation       = generation.raw32[0];
+    wear_leveling.background.state = BACKGROUND_IDLE;
+    wl_count(consolidations);
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Performs a single bounded step of background consolidation. The backing store must already be unlocked.
+ *
+ * @return WEAR_LEVELING_SUCCESS if more steps remain, WEAR_LEVELING_CONSOLIDATED once switched over
+ */
+static wear_leveling_status_t wear_leveling_background_step(void) {
+    const uint32_t spare_base = wear_leveling.bank_base ^ (WEAR_LEVELING_BANK_SIZE);
+    switch (wear_leveling.background.state) {
+        case BACKGROUND_ERASE: {
+            wl_dprintf("Background: erasing bank %d\n", (int)(spare_base / (WEAR_LEVELING_BANK_SIZE)));
+            if (!backing_store_erase_bank(spare_base / (WEAR_LEVELING_BANK_SIZE))) {
+                wl_dprintf("Background: failed to erase bank, using synchronous consolidation from now on\n");
+                wear_leveling.background.unsupported = true;
+                wear_leveling.background.state       = BACKGROUND_IDLE;
+                return WEAR_LEVELING_FAILED;
+            }
+            wl_count(erases);
+            wear_leveling.background.copy_offset = 0;
+            wear_leveling.background.copy_hash   = FNV1A_64_INIT;
+            wear_leveling.background.dirty_start = (WEAR_LEVELING_LOGICAL_SIZE);
+            wear_leveling.background.dirty_end   = 0;
+            wear_leveling.background.state       = BACKGROUND_COPY;
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case BACKGROUND_COPY: {
+            const uint32_t offset = wear_leveling.background.copy_offset;
+            const uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE)-offset < (WEAR_LEVELING_BACKGROUND_STEP_SIZE) ? (WEAR_LEVELING_LOGICAL_SIZE)-offset : (WEAR_LEVELING_BACKGROUND_STEP_SIZE);
+            if (!backing_store_write_bulk(spare_base + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / sizeof(backing_store_int_t))) {
+                wl_dprintf("Background: failed to copy to spare bank\n");
+                wear_leveling.background.state = BACKGROUND_IDLE;
+                return WEAR_LEVELING_FAILED;
+            }
+            wear_leveling.background.copy_hash = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling.background.copy_hash);
+            wear_leveling.background.copy_offset += length;
+            if (wear_leveling.background.copy_offset >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.background.state = BACKGROUND_SEAL;
+            }
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        case BACKGROUND_SEAL:
+            return wear_leveling_background_seal(spare_base);
+
+        default:
+            return WEAR_LEVELING_SUCCESS;
+    }
+}
+
+/**
+ * Runs all remaining background steps in-line, starting a consolidation if none is in progress.
+ */
+static wear_leveling_status_t wear_leveling_background_finish(void) {
+    if (wear_leveling.background.unsupported) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    if (wear_leveling.background.state == BACKGROUND_IDLE) {
+        wear_leveling.background.state = BACKGROUND_ERASE;
+    }
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_background_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Advances background consolidation by a single step.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    if (wear_leveling.background.unsupported) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    if (wear_leveling.background.state == BACKGROUND_IDLE) {
+        if (wear_leveling.write_address - wear_leveling.bank_base < (WEAR_LEVELING_LOG_OFFSET) + (WEAR_LEVELING_BACKGROUND_THRESHOLD)) {
+            return WEAR_LEVELING_SUCCESS;
+        }
+        wear_leveling.background.state = BACKGROUND_ERASE;
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_background_step();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 /**
  * Wear-leveling initialization
  */
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef EEPROM_STATS_ENABLE
+    wear_leveling_reset_stats();
+#endif // EEPROM_STATS_ENABLE
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling.bank_base              = 0;
+    wear_leveling.generation             = 0;
+    wear_leveling.background.state       = BACKGROUND_IDLE;
+    wear_leveling.background.unsupported = false;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -627,8 +970,23 @@ wear_leveling_status_t wear_leveling_init(void) {
         return WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Read the newest valid bank, then replay its write log so that the cache has the "live" values
+    if (!wear_leveling_select_bank()) {
+        // Neither write log can be trusted without valid consolidated data, so start afresh
+        wl_dprintf("No valid bank, clearing cache\n");
+        wear_leveling_clear_cache();
+        return wear_leveling_consolidate_force();
+    }
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (!backing_store_read_bulk(wear_leveling.bank_base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+        wl_dprintf("Failed to read from backing store\n");
+        status = WEAR_LEVELING_FAILED;
+    }
+#else
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
     wear_leveling_status_t status = wear_leveling_read_consolidated();
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
     if (status == WEAR_LEVELING_FAILED) {
         // If it failed, clear the cache and return with failure
         wear_leveling_clear_cache();
@@ -661,7 +1019,20 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+    if (ret) {
+        wl_count(erases);
+    }
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling.bank_base        = 0;
+    wear_leveling.generation       = 0;
+    wear_leveling.background.state = BACKGROUND_IDLE;
+    wear_leveling_clear_cache();
+
+    // The write log is only trusted alongside valid consolidated data, so write the cleared cache out straight away
+    ret &= (wear_leveling_write_consolidated() != WEAR_LEVELING_FAILED);
+#else
     wear_leveling_clear_cache();
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -690,6 +1061,9 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
 
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling_background_touch(address, length);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
@@ -726,6 +1100,66 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Writes logical data into the cache, deferring the write log append to wear_leveling_commit().
+ */
+wear_leveling_status_t wear_leveling_write_cached(const uint32_t address, const void *value, size_t length) {
+    wl_assert(address + length <= (WEAR_LEVELING_LOGICAL_SIZE));
+    if (address + length > (WEAR_LEVELING_LOGICAL_SIZE)) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Write cached ");
+    wl_dump(address, value, length);
+
+    memcpy(&wear_leveling.cache[address], value, length);
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling_background_touch(address, length);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Appends the cached contents of each range to the write log, unlocking the backing store once for the whole batch.
+ */
+wear_leveling_status_t wear_leveling_commit(const wear_leveling_range_t *ranges, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        wl_assert(ranges[i].address + ranges[i].length <= (WEAR_LEVELING_LOGICAL_SIZE));
+        if (ranges[i].address + ranges[i].length > (WEAR_LEVELING_LOGICAL_SIZE)) {
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (size_t i = 0; i < count && status == WEAR_LEVELING_SUCCESS; ++i) {
+        wl_dprintf("Commit ");
+        wl_dump(ranges[i].address, &wear_leveling.cache[ranges[i].address], ranges[i].length);
+
+        // If this triggers consolidation then the whole cache, including any later ranges, has already been persisted.
+        status = wear_leveling_write_raw(ranges[i].address, &wear_leveling.cache[ranges[i].address], ranges[i].length);
+    }
+
+    if (status == WEAR_LEVELING_SUCCESS) {
+        // Consolidate the cache + write log if required
+        status = wear_leveling_consolidate_if_needed();
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
 /**
  * Reads logical data from the cache.
  */
@@ -743,6 +1177,22 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+#ifdef EEPROM_STATS_ENABLE
+/**
+ * Backing store activity counters.
+ */
+const wear_leveling_stats_t *wear_leveling_get_stats(void) {
+    return &wear_leveling.stats;
+}
+
+/**
+ * Clear the backing store activity counters.
+ */
+void wear_leveling_reset_stats(void) {
+    memset(&wear_leveling.stats, 0, sizeof(wear_leveling.stats));
+}
+#endif // EEPROM_STATS_ENABLE
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -766,3 +1216,12 @@ __attribute__((weak)) bool backing_store_write_bulk(uint32_t address, backing_st
     }
     return true;
 }
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Weak implementation of single bank erasure, drivers able to erase half of the backing store should override this.
+ */
+__attribute__((weak)) bool backing_store_erase_bank(uint8_t bank) {
+    return false;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
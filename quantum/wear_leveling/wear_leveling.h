@@ -13,6 +13,37 @@ typedef enum wear_leveling_status_t {
     WEAR_LEVELING_CONSOLIDATED //< Invocation succeeded, consolidation occurred
 } wear_leveling_status_t;
 
+/**
+ * @typedef Logical address range, used when committing deferred writes.
+ */
+typedef struct wear_leveling_range_t {
+    uint32_t address;
+    uint32_t length;
+} wear_leveling_range_t;
+
+#ifdef EEPROM_STATS_ENABLE
+/**
+ * @typedef Counters of backing store activity since wear_leveling_init().
+ */
+typedef struct wear_leveling_stats_t {
+    uint32_t appends;        //< Entries appended to the write log
+    uint32_t consolidations; //< Times the cache was written out as new consolidated data
+    uint32_t erases;         //< Erasures of the backing store, or of a single bank
+} wear_leveling_stats_t;
+
+/**
+ * Gets the backing store activity counters. Only available with EEPROM_STATS_ENABLE.
+ *
+ * @return Pointer to the counters
+ */
+const wear_leveling_stats_t* wear_leveling_get_stats(void);
+
+/**
+ * Clears the backing store activity counters. Only available with EEPROM_STATS_ENABLE.
+ */
+void wear_leveling_reset_stats(void);
+#endif // EEPROM_STATS_ENABLE
+
 /**
  * Wear-leveling initialization
  *
@@ -52,3 +83,36 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Writes logical data into the cache only, without appending to the write log.
+ *
+ * Reads observe the new data immediately. The data is only persisted once the containing range is passed to
+ * wear_leveling_commit(), or when a later write triggers consolidation.
+ *
+ * @param address[in] the logical address to write data
+ * @param value[in] pointer to the source buffer
+ * @param length[in] length of the data
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_write_cached(uint32_t address, const void* value, size_t length);
+
+/**
+ * Appends the cached contents of the supplied logical ranges to the write log.
+ *
+ * The backing store is unlocked once for the whole batch. If the log fills up part-way through, the consolidation
+ * persists the entire cache and the remaining ranges are skipped.
+ *
+ * @param ranges[in] the logical ranges to persist
+ * @param count[in] number of ranges
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_commit(const wear_leveling_range_t* ranges, size_t count);
+
+/**
+ * Advances any in-progress background consolidation by a single bounded step, starting a new one once the write log
+ * passes its threshold. Only available with WEAR_LEVELING_BACKGROUND_CONSOLIDATION.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the switch-over to the new bank has occurred, otherwise status of the step
+ */
+wear_leveling_status_t wear_leveling_task(void);
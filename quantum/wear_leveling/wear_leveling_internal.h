@@ -66,6 +66,24 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// The backing store is split into two banks, each holding consolidated data, its FNV1a_64, a generation counter and a write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16)
+#    ifndef WEAR_LEVELING_BACKGROUND_STEP_SIZE
+#        define WEAR_LEVELING_BACKGROUND_STEP_SIZE 64
+#    endif
+#    ifndef WEAR_LEVELING_BACKGROUND_THRESHOLD
+#        define WEAR_LEVELING_BACKGROUND_THRESHOLD (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET)) / 2)
+#    endif
+_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 4), "Total backing size must be at least four times the logical size for background consolidation");
+_Static_assert(WEAR_LEVELING_BACKGROUND_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Background consolidation step size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_BACKGROUND_THRESHOLD < (WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET), "Background consolidation threshold must leave room in the write log");
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 8)
+#endif
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
@@ -75,6 +93,7 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+bool backing_store_erase_bank(uint8_t bank); // weak implementation already provided which reports failure, required by drivers supporting background consolidation
 
 /**
  * Helper type used to contain a write log entry.
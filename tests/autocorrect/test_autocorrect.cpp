@@ -202,3 +202,101 @@ TEST_F(AutoCorrect, overture_should_not_autocorrect) {
 
     VERIFY_AND_CLEAR(driver);
 }
+
+// Test that a typo is still found when it starts partway through a repeated letter
+TEST_F(AutoCorrect, ffales_to_ffalse_autocorrect) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F))).Times(2);
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys(key_f, key_f, key_a, key_l, key_e, key_s);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Test that a typo completed after a backspace is still corrected
+TEST_F(AutoCorrect, fales_after_backspace_autocorrect) {
+    TestDriver driver;
+    auto       key_f    = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a    = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l    = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e    = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s    = KeymapKey(0, 4, 0, KC_S);
+    auto       key_x    = KeymapKey(0, 5, 0, KC_X);
+    auto       key_bspc = KeymapKey(0, 6, 0, KC_BSPC);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s, key_x, key_bspc});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_X)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys(key_f, key_a, key_l, key_x, key_bspc, key_e, key_s);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Test that a typo starting inside another typo's prefix is found through a failure link
+TEST_F(AutoCorrect, fitlenght_to_fitlength_autocorrect) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_i = KeymapKey(0, 1, 0, KC_I);
+    auto       key_t = KeymapKey(0, 2, 0, KC_T);
+    auto       key_l = KeymapKey(0, 3, 0, KC_L);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_n = KeymapKey(0, 5, 0, KC_N);
+    auto       key_g = KeymapKey(0, 6, 0, KC_G);
+    auto       key_h = KeymapKey(0, 7, 0, KC_H);
+
+    set_keymap({key_f, key_i, key_t, key_l, key_e, key_n, key_g, key_h});
+
+    // Allow any number of empty reports.
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    { // Expect the following reports in this order.
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_I)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_T)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_N)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_G)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_T)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_H)));
+    }
+
+    TapKeys(key_f, key_i, key_t, key_l, key_e, key_n, key_g, key_h, key_t);
+
+    VERIFY_AND_CLEAR(driver);
+}
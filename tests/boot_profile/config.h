@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define KEYBOARD_DEFERRED_INIT
+#define KEYBOARD_DEFERRED_INIT_IDLE 10
+#define KEYBOARD_DEFERRED_INIT_TIMEOUT 100
@@ -0,0 +1,111 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+static int deferred_init_calls = 0;
+
+extern "C" void keyboard_deferred_init_user(void) {
+    deferred_init_calls++;
+}
+
+class BootProfile : public TestFixture {
+   public:
+    bool reached(const boot_profile_t *profile, boot_phase_t phase) {
+        return profile->recorded & (1 << phase);
+    }
+};
+
+TEST_F(BootProfile, FirstScanAndReportAreTimed) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    boot_profile_start(BOOT_REASON_WAKE);
+    idle_for(5);
+    const boot_profile_t *profile = boot_profile_get(false);
+    ASSERT_NE(profile, nullptr);
+    EXPECT_EQ(profile->reason, BOOT_REASON_WAKE);
+    EXPECT_TRUE(reached(profile, BOOT_PHASE_FIRST_SCAN));
+    EXPECT_FALSE(reached(profile, BOOT_PHASE_FIRST_REPORT));
+    EXPECT_EQ(profile->elapsed[BOOT_PHASE_FIRST_SCAN], 0);
+
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_TRUE(reached(profile, BOOT_PHASE_FIRST_REPORT));
+    EXPECT_EQ(profile->elapsed[BOOT_PHASE_FIRST_REPORT], 5);
+
+    // Later reports don't move the first one
+    key_a.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_EQ(profile->elapsed[BOOT_PHASE_FIRST_REPORT], 5);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BootProfile, StartKeepsPreviousProfile) {
+    TestDriver driver;
+
+    boot_profile_start(BOOT_REASON_RESET);
+    idle_for(3);
+    boot_profile_mark(BOOT_PHASE_KB_0);
+
+    boot_profile_start(BOOT_REASON_WAKE);
+    const boot_profile_t *previous = boot_profile_get(true);
+    const boot_profile_t *current  = boot_profile_get(false);
+    ASSERT_NE(previous, nullptr);
+    ASSERT_NE(current, nullptr);
+    EXPECT_EQ(previous->reason, BOOT_REASON_RESET);
+    EXPECT_TRUE(reached(previous, BOOT_PHASE_KB_0));
+    EXPECT_EQ(previous->elapsed[BOOT_PHASE_KB_0], 3);
+    EXPECT_EQ(current->reason, BOOT_REASON_WAKE);
+    EXPECT_EQ(current->recorded, 0);
+}
+
+TEST_F(BootProfile, DeferredInitWaitsForHeldKey) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    keyboard_deferred_init_wait();
+    key_a.press();
+    housekeeping_task();
+    EXPECT_EQ(deferred_init_calls, 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    housekeeping_task();
+    EXPECT_EQ(deferred_init_calls, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Runs once the matrix has been idle for KEYBOARD_DEFERRED_INIT_IDLE
+    idle_for(KEYBOARD_DEFERRED_INIT_IDLE);
+    housekeeping_task();
+    housekeeping_task();
+    EXPECT_EQ(deferred_init_calls, 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(BootProfile, DeferredInitReadyAfterTimeoutWhileTyping) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    keyboard_deferred_init_wait();
+    for (int i = 0; i < KEYBOARD_DEFERRED_INIT_TIMEOUT; i += 5) {
+        EXPECT_FALSE(keyboard_deferred_init_ready());
+        tap_key(key_a, 4);
+    }
+    EXPECT_TRUE(keyboard_deferred_init_ready());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -55,3 +55,79 @@ TEST_F(Combo, combo_osmshift_tapped) {
     tap_key(key_i);
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Combo, overlapping_combo_shorter) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    KeymapKey  key_s(0, 0, 2, KC_S);
+    KeymapKey  key_d(0, 0, 3, KC_D);
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_s, key_d});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, overlapping_combo_longest_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    KeymapKey  key_s(0, 0, 2, KC_S);
+    KeymapKey  key_d(0, 0, 3, KC_D);
+    set_keymap({key_a, key_s, key_d});
+
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_s, key_d});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, combo_key_alone_is_sent) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    KeymapKey  key_q(0, 0, 2, KC_Q);
+    set_keymap({key_a, key_q});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_q);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, overlapping_combo_same_length_later_wins) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 0, 1, KC_J);
+    KeymapKey  key_k(0, 0, 2, KC_K);
+    KeymapKey  key_l(0, 0, 3, KC_L);
+    set_keymap({key_j, key_k, key_l});
+
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_REPORT(driver, (KC_J, KC_2));
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    key_j.press();
+    run_one_scan_loop();
+    key_k.press();
+    run_one_scan_loop();
+    key_l.press();
+    run_one_scan_loop();
+    idle_for(COMBO_TERM + 1);
+    key_j.release();
+    run_one_scan_loop();
+    key_k.release();
+    run_one_scan_loop();
+    key_l.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -4,14 +4,24 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "quantum.h"
 
-enum combos { modtest, osmshift };
+enum combos { modtest, osmshift, as_esc, asd_tab, sd_enter, jk_one, kl_two };
 
 uint16_t const modtest_combo[]  = {KC_Y, KC_U, COMBO_END};
 uint16_t const osmshift_combo[] = {KC_Z, KC_X, COMBO_END};
+uint16_t const as_combo[]       = {KC_A, KC_S, COMBO_END};
+uint16_t const asd_combo[]      = {KC_A, KC_S, KC_D, COMBO_END};
+uint16_t const sd_combo[]       = {KC_S, KC_D, COMBO_END};
+uint16_t const jk_combo[]       = {KC_J, KC_K, COMBO_END};
+uint16_t const kl_combo[]       = {KC_K, KC_L, COMBO_END};
 
 // clang-format off
 combo_t key_combos[] = {
     [modtest]  = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
-    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT))
+    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT)),
+    [as_esc]   = COMBO(as_combo, KC_ESC),
+    [asd_tab]  = COMBO(asd_combo, KC_TAB),
+    [sd_enter] = COMBO(sd_combo, KC_ENTER),
+    [jk_one]   = COMBO(jk_combo, KC_1),
+    [kl_two]   = COMBO(kl_combo, KC_2)
 };
 // clang-format on
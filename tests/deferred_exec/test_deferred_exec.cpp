@@ -0,0 +1,145 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "wait.h"
+}
+
+namespace {
+
+struct Recorder {
+    std::vector<int> calls;
+    uint32_t         repeat = 0;
+};
+
+struct Tag {
+    Recorder *recorder;
+    int       id;
+};
+
+uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    Tag *tag = static_cast<Tag *>(cb_arg);
+    tag->recorder->calls.push_back(tag->id);
+    return tag->recorder->repeat;
+}
+
+} // namespace
+
+class DeferredExec : public TestFixture {
+   public:
+    deferred_executor_t table[8]           = {};
+    uint32_t            last_execution_time = 0;
+
+    void SetUp() override {
+        last_execution_time = timer_read32();
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            wait_ms(1);
+            deferred_exec_advanced_task(table, 8, &last_execution_time);
+        }
+    }
+};
+
+TEST_F(DeferredExec, RunsInTriggerOrder) {
+    Recorder recorder;
+    Tag      tags[] = {{&recorder, 0}, {&recorder, 1}, {&recorder, 2}, {&recorder, 3}};
+
+    defer_exec_advanced(table, 8, 40, record_callback, &tags[0]);
+    defer_exec_advanced(table, 8, 10, record_callback, &tags[1]);
+    defer_exec_advanced(table, 8, 30, record_callback, &tags[2]);
+    defer_exec_advanced(table, 8, 20, record_callback, &tags[3]);
+
+    run_for(25);
+    EXPECT_EQ(recorder.calls, (std::vector<int>{1, 3}));
+    run_for(20);
+    EXPECT_EQ(recorder.calls, (std::vector<int>{1, 3, 2, 0}));
+
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_advanced_next_deadline(table, 8, &trigger_time));
+}
+
+TEST_F(DeferredExec, NextDeadlineTracksEarliest) {
+    Recorder recorder;
+    Tag      tags[] = {{&recorder, 0}, {&recorder, 1}};
+    uint32_t now    = timer_read32();
+    uint32_t trigger_time;
+
+    deferred_token late  = defer_exec_advanced(table, 8, 50, record_callback, &tags[0]);
+    deferred_token early = defer_exec_advanced(table, 8, 20, record_callback, &tags[1]);
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, 8, &trigger_time));
+    EXPECT_EQ(trigger_time, now + 20);
+
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, 8, early, 80));
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, 8, &trigger_time));
+    EXPECT_EQ(trigger_time, now + 50);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 8, late));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, 8, late));
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, 8, &trigger_time));
+    EXPECT_EQ(trigger_time, now + 80);
+
+    run_for(100);
+    EXPECT_EQ(recorder.calls, (std::vector<int>{1}));
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToPreviousTrigger) {
+    Recorder recorder;
+    Tag      tag = {&recorder, 0};
+    recorder.repeat = 10;
+
+    uint32_t       start = timer_read32();
+    deferred_token token = defer_exec_advanced(table, 8, 10, record_callback, &tag);
+
+    // Stall for a while; the repeat still lines up with the original schedule
+    wait_ms(15);
+    deferred_exec_advanced_task(table, 8, &last_execution_time);
+    EXPECT_EQ(recorder.calls.size(), 1u);
+
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, 8, &trigger_time));
+    EXPECT_EQ(trigger_time, start + 20);
+
+    run_for(15);
+    EXPECT_EQ(recorder.calls.size(), 3u);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 8, token));
+}
+
+TEST_F(DeferredExec, LaggingRepeaterRunsOncePerPass) {
+    Recorder recorder;
+    Tag      tags[] = {{&recorder, 0}, {&recorder, 1}};
+    recorder.repeat = 1;
+
+    deferred_token repeater = defer_exec_advanced(table, 8, 1, record_callback, &tags[0]);
+    deferred_token other    = defer_exec_advanced(table, 8, 5, record_callback, &tags[1]);
+
+    // Stall well past both; the repeater is still due after each run but must not hold back the other one
+    wait_ms(20);
+    deferred_exec_advanced_task(table, 8, &last_execution_time);
+    EXPECT_EQ(recorder.calls, (std::vector<int>{0, 1}));
+
+    run_for(1);
+    EXPECT_EQ(recorder.calls, (std::vector<int>{0, 1, 0, 1}));
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 8, repeater));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 8, other));
+}
+
+TEST_F(DeferredExec, TableFull) {
+    Recorder recorder;
+    Tag      tag = {&recorder, 0};
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_NE(defer_exec_advanced(table, 8, 10 + i, record_callback, &tag), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec_advanced(table, 8, 10, record_callback, &tag), INVALID_DEFERRED_TOKEN);
+
+    run_for(20);
+    EXPECT_EQ(recorder.calls.size(), 8u);
+}
@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 512
+#define DYNAMIC_KEYMAP_LAYER_COUNT 8
+#define DYNAMIC_KEYMAP_MACRO_COUNT 4
+#define DYNAMIC_KEYMAP_SPARSE_LAYERS
+#define DYNAMIC_KEYMAP_DENSE_LAYER_COUNT 1
+#define DYNAMIC_KEYMAP_SPARSE_KEY_COUNT 24
@@ -0,0 +1,164 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+#define KEYS_PER_LAYER (MATRIX_ROWS * MATRIX_COLS)
+#define KEYMAP_BUFFER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER * 2)
+
+class DynamicKeymapSparse : public TestFixture {
+   public:
+    // What the keymap should contain, in flat buffer order
+    std::array<uint16_t, DYNAMIC_KEYMAP_LAYER_COUNT * KEYS_PER_LAYER> expected;
+    uint16_t                                                          sparse_used;
+
+    void SetUp() override {
+        dynamic_keymap_macro_reset();
+        dynamic_keymap_reset();
+        expected.fill(KC_TRNS);
+        for (int i = 0; i < KEYS_PER_LAYER; i++) {
+            expected[i] = KC_NO;
+        }
+        sparse_used = 0;
+    }
+
+    // Mirrors the sparse pool running out of room
+    void set_expected(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+        uint16_t &slot = expected[(layer * MATRIX_ROWS + row) * MATRIX_COLS + column];
+        if (layer >= DYNAMIC_KEYMAP_DENSE_LAYER_COUNT) {
+            if (slot == KC_TRNS && keycode != KC_TRNS) {
+                if (sparse_used == DYNAMIC_KEYMAP_SPARSE_KEY_COUNT) {
+                    return;
+                }
+                sparse_used++;
+            } else if (slot != KC_TRNS && keycode == KC_TRNS) {
+                sparse_used--;
+            }
+        }
+        slot = keycode;
+    }
+
+    void verify(const char *context) {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                    ASSERT_EQ(dynamic_keymap_get_keycode(layer, row, column), expected[(layer * MATRIX_ROWS + row) * MATRIX_COLS + column]) << context << ": layer " << (int)layer << " row " << (int)row << " column " << (int)column;
+                }
+            }
+        }
+
+        std::vector<uint8_t> buffer(KEYMAP_BUFFER_SIZE);
+        dynamic_keymap_get_buffer(0, buffer.size(), buffer.data());
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ((buffer[i * 2] << 8) | buffer[i * 2 + 1], expected[i]) << context << ": buffer keycode " << i;
+        }
+    }
+};
+
+TEST_F(DynamicKeymapSparse, ResetLoadsDefaults) {
+    verify("after reset");
+}
+
+TEST_F(DynamicKeymapSparse, SetAndClearKeys) {
+    for (uint8_t layer = DYNAMIC_KEYMAP_DENSE_LAYER_COUNT; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        dynamic_keymap_set_keycode(layer, layer % MATRIX_ROWS, layer, KC_A + layer);
+        set_expected(layer, layer % MATRIX_ROWS, layer, KC_A + layer);
+    }
+    verify("after setting one key per layer");
+
+    // Insert before existing keys, then remove from the middle
+    dynamic_keymap_set_keycode(1, 0, 0, KC_NO);
+    set_expected(1, 0, 0, KC_NO);
+    dynamic_keymap_set_keycode(4, 0, 4, KC_TRNS);
+    set_expected(4, 0, 4, KC_TRNS);
+    dynamic_keymap_set_keycode(2, 2, 2, KC_Z);
+    set_expected(2, 2, 2, KC_Z);
+    verify("after inserting and removing");
+}
+
+TEST_F(DynamicKeymapSparse, PoolFullKeepsKeyTransparent) {
+    for (int i = 0; i < DYNAMIC_KEYMAP_SPARSE_KEY_COUNT; i++) {
+        dynamic_keymap_set_keycode(1 + i / KEYS_PER_LAYER, (i / MATRIX_COLS) % MATRIX_ROWS, i % MATRIX_COLS, KC_1);
+        set_expected(1 + i / KEYS_PER_LAYER, (i / MATRIX_COLS) % MATRIX_ROWS, i % MATRIX_COLS, KC_1);
+    }
+    verify("with a full pool");
+
+    dynamic_keymap_set_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1, 0, 0, KC_2);
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1, 0, 0), KC_TRNS) << "Key should not have fit";
+
+    // Replacing a key in place still works, and clearing one makes room
+    dynamic_keymap_set_keycode(1, 0, 0, KC_3);
+    set_expected(1, 0, 0, KC_3);
+    dynamic_keymap_set_keycode(1, 0, 1, KC_TRNS);
+    set_expected(1, 0, 1, KC_TRNS);
+    dynamic_keymap_set_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1, 0, 0, KC_2);
+    set_expected(DYNAMIC_KEYMAP_LAYER_COUNT - 1, 0, 0, KC_2);
+    verify("after making room");
+}
+
+TEST_F(DynamicKeymapSparse, RandomEditsMatchFlatLayout) {
+    std::mt19937                       rng(1234);
+    std::uniform_int_distribution<int> layer_dist(0, DYNAMIC_KEYMAP_LAYER_COUNT - 1);
+    std::uniform_int_distribution<int> row_dist(0, MATRIX_ROWS - 1);
+    std::uniform_int_distribution<int> column_dist(0, MATRIX_COLS - 1);
+    std::uniform_int_distribution<int> keycode_dist(0, 3);
+
+    for (int i = 0; i < 2000; i++) {
+        uint8_t  layer   = layer_dist(rng);
+        uint8_t  row     = row_dist(rng);
+        uint8_t  column  = column_dist(rng);
+        uint16_t keycode = keycode_dist(rng) == 0 ? KC_TRNS : (uint16_t)(KC_A + (rng() % 0x100));
+        dynamic_keymap_set_keycode(layer, row, column, keycode);
+        set_expected(layer, row, column, keycode);
+        if (i % 100 == 0) {
+            verify(("after edit " + std::to_string(i)).c_str());
+        }
+    }
+    verify("after all edits");
+}
+
+TEST_F(DynamicKeymapSparse, BufferPresentsFlatLayout) {
+    std::vector<uint8_t> buffer(KEYMAP_BUFFER_SIZE);
+    for (size_t i = 0; i < expected.size(); i++) {
+        // Mostly transparent, with big-endian keycodes spanning both halves, and more than the pool can hold
+        uint16_t keycode  = (i % 7 == 0) ? (uint16_t)(0x0100 + i) : (i < KEYS_PER_LAYER ? KC_NO : KC_TRNS);
+        buffer[i * 2]     = keycode >> 8;
+        buffer[i * 2 + 1] = keycode & 0xFF;
+        set_expected(i / KEYS_PER_LAYER, (i / MATRIX_COLS) % MATRIX_ROWS, i % MATRIX_COLS, keycode);
+    }
+    EXPECT_EQ(sparse_used, DYNAMIC_KEYMAP_SPARSE_KEY_COUNT);
+
+    // Odd sized chunks, as a host might send them, so keycodes get split across requests
+    for (size_t offset = 0; offset < buffer.size(); offset += 27) {
+        dynamic_keymap_set_buffer(offset, std::min<size_t>(27, buffer.size() - offset), buffer.data() + offset);
+    }
+    verify("after writing the buffer");
+
+    // Reads that start part way through a keycode
+    uint8_t pair[2];
+    for (size_t i = 0; i + 1 < expected.size(); i++) {
+        dynamic_keymap_get_buffer(i * 2 + 1, sizeof(pair), pair);
+        EXPECT_EQ(pair[0], expected[i] & 0xFF) << "offset " << i * 2 + 1;
+        EXPECT_EQ(pair[1], expected[i + 1] >> 8) << "offset " << i * 2 + 1;
+    }
+}
+
+TEST_F(DynamicKeymapSparse, MacrosDoNotOverlapKeymap) {
+    for (int i = 0; i < DYNAMIC_KEYMAP_SPARSE_KEY_COUNT; i++) {
+        dynamic_keymap_set_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1 - i / KEYS_PER_LAYER, (i / MATRIX_COLS) % MATRIX_ROWS, i % MATRIX_COLS, KC_B);
+        set_expected(DYNAMIC_KEYMAP_LAYER_COUNT - 1 - i / KEYS_PER_LAYER, (i / MATRIX_COLS) % MATRIX_ROWS, i % MATRIX_COLS, KC_B);
+    }
+
+    std::vector<uint8_t> macros(dynamic_keymap_macro_get_buffer_size(), 0xAA);
+    macros.back() = 0;
+    dynamic_keymap_macro_set_buffer(0, macros.size(), macros.data());
+    verify("after filling the macro buffer");
+
+    std::vector<uint8_t> readback(macros.size());
+    dynamic_keymap_macro_get_buffer(0, readback.size(), readback.data());
+    EXPECT_EQ(readback, macros);
+}
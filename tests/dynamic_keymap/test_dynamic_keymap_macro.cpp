@@ -0,0 +1,236 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static bool transport_ready = true;
+
+extern "C" bool send_string_transport_ready(void) {
+    return transport_ready;
+}
+
+class DynamicKeymapMacro : public TestFixture {
+   public:
+    void SetUp() override {
+        transport_ready = true;
+        dynamic_keymap_macro_reset();
+    }
+
+    // Macros are stored back to back, each with its null terminator
+    void set_macros(std::initializer_list<std::string> macros) {
+        std::string buffer;
+        for (const auto &macro : macros) {
+            buffer += macro;
+            buffer.push_back(0);
+        }
+        dynamic_keymap_macro_set_buffer(0, buffer.size(), (uint8_t *)buffer.data());
+    }
+
+    void play_until_done(unsigned limit = 1000) {
+        while (dynamic_keymap_macro_is_playing() && limit-- > 0) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+    }
+};
+
+TEST_F(DynamicKeymapMacro, SendReturnsBeforeTyping) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"ab"});
+
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    EXPECT_TRUE(dynamic_keymap_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, OneReportPerLoop) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"A"});
+    dynamic_keymap_macro_send(0);
+
+    // Start and decode
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    play_until_done();
+}
+
+TEST_F(DynamicKeymapMacro, DelayHonoured) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"a" SS_DELAY(100) "b"});
+    dynamic_keymap_macro_send(0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, DownUpAndTapCodes) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({SS_DOWN(X_LCTL) SS_TAP(X_C) SS_UP(X_LCTL)});
+    dynamic_keymap_macro_send(0);
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, CapsLockHeldForCapsDelay) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({SS_TAP(X_CAPS)});
+    dynamic_keymap_macro_send(0);
+
+    EXPECT_REPORT(driver, (KC_CAPS_LOCK));
+    idle_for(TAP_HOLD_CAPS_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, SelectsMacroById) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"a", "", "c"});
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(2);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+
+    // Empty, and past the last macro in the buffer
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    play_until_done();
+    dynamic_keymap_macro_send(3);
+    play_until_done();
+    dynamic_keymap_macro_send(DYNAMIC_KEYMAP_MACRO_COUNT);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, IndexFollowsBufferWrites) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"a", "b"});
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+
+    set_macros({"xyz", "c"});
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, IncompleteBufferIgnored) {
+    TestDriver driver;
+
+    set_macros({"a"});
+    uint8_t busy = 0xFF;
+    dynamic_keymap_macro_set_buffer(dynamic_keymap_macro_get_buffer_size() - 1, 1, &busy);
+
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, QueuedMacrosPlayInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"a", "b"});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, WaitsForTransport) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({"a"});
+    dynamic_keymap_macro_send(0);
+
+    transport_ready = false;
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    EXPECT_TRUE(dynamic_keymap_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    transport_ready = true;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
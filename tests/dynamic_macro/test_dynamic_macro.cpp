@@ -0,0 +1,267 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   public:
+    KeymapKey key_rec1 = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey key_rstp = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey key_ply1 = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey key_a    = KeymapKey(0, 3, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    void SetUp() override {
+        dynamic_keymap_macro_reset();
+    }
+
+    void play_until_done(unsigned limit = 1000) {
+        while ((dynamic_macro_is_playing() || dynamic_keymap_macro_is_playing()) && limit-- > 0) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(dynamic_macro_is_playing());
+    }
+};
+
+TEST_F(DynamicMacro, plays_back_with_recorded_timing) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    idle_for(50);
+    tap_key(key_b);
+    tap_key(key_rstp);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+
+    /* Playback starts on release, and returns straight away */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply1);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* B follows as long after A as it did when recorded */
+    EXPECT_NO_REPORT(driver);
+    idle_for(45);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(dynamic_macro_is_playing());
+}
+
+TEST_F(DynamicMacro, keys_held_by_the_user_survive_playback) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    idle_for(50);
+    tap_key(key_a);
+    tap_key(key_rstp);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The user holds B while the macro is still playing */
+    EXPECT_REPORT(driver, (KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, keys_left_held_by_the_macro_are_released) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    key_a.press();
+    run_one_scan_loop();
+    tap_key(key_b);
+    tap_key(key_rstp);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, long_pauses_are_saturated) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    idle_for(70000);
+    tap_key(key_b);
+    tap_key(key_rstp);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The pause does not wrap around to a few seconds */
+    EXPECT_NO_REPORT(driver);
+    idle_for(65000);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(dynamic_macro_is_playing());
+}
+
+TEST_F(DynamicMacro, holds_several_times_more_events) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    // 20 events, where the buffer used to hold DYNAMIC_MACRO_SIZE of them
+    for (int i = 0; i < 10; i++) {
+        tap_key(i % 2 ? key_b : key_a);
+    }
+    tap_key(key_rstp);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    for (int i = 0; i < 10; i++) {
+        if (i % 2) {
+            EXPECT_REPORT(driver, (KC_B));
+        } else {
+            EXPECT_REPORT(driver, (KC_A));
+        }
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_ply1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, replays_mod_tap_taps) {
+    TestDriver driver;
+    auto       key_mt = KeymapKey(0, 5, 0, SFT_T(KC_P));
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_mt});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_mt);
+    tap_key(key_rstp);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, trailing_presses_are_trimmed) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    key_b.press();
+    run_one_scan_loop();
+    tap_key(key_rstp);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, persists_into_dynamic_keymap_macro) {
+    TestDriver driver;
+
+    set_keymap({key_rec1, key_rstp, key_ply1, key_a, key_b});
+
+    std::string macros("x\0old\0y\0", 8);
+    dynamic_keymap_macro_set_buffer(0, macros.size(), (uint8_t *)macros.data());
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    idle_for(20);
+    tap_key(key_b);
+    tap_key(key_rstp);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_TRUE(dynamic_macro_persist(1, 1));
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    dynamic_keymap_macro_send(2);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
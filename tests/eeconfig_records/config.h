@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 256
+#define EECONFIG_KB_DATA_SIZE 16
+#define EECONFIG_USER_DATA_SIZE 8
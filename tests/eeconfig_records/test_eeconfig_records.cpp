@@ -0,0 +1,169 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "crc.h"
+}
+
+#define KB_COPY_SIZE (EECONFIG_KB_DATA_SIZE + EECONFIG_RECORD_OVERHEAD)
+
+typedef std::array<uint8_t, EECONFIG_KB_DATA_SIZE> kb_data_t;
+
+class EeconfigRecords : public TestFixture {
+   public:
+    void SetUp() override {
+        eeconfig_init_quantum();
+    }
+
+    kb_data_t make_data(uint8_t seed) {
+        kb_data_t data;
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = seed + i;
+        }
+        return data;
+    }
+
+    kb_data_t read_kb(void) {
+        kb_data_t data;
+        eeconfig_read_kb_datablock(data.data());
+        return data;
+    }
+
+    uint8_t *kb_copy(uint8_t copy) {
+        return EECONFIG_KB_DATABLOCK + copy * KB_COPY_SIZE;
+    }
+
+    // Index of the copy currently holding the given data
+    uint8_t find_copy(const kb_data_t &data) {
+        for (uint8_t copy = 0; copy < 2; copy++) {
+            kb_data_t stored;
+            eeprom_read_block(stored.data(), kb_copy(copy), stored.size());
+            if (stored == data) {
+                return copy;
+            }
+        }
+        ADD_FAILURE() << "Data not found in either copy";
+        return 0;
+    }
+
+    void corrupt(uint8_t *address) {
+        eeprom_update_byte(address, eeprom_read_byte(address) ^ 0x5A);
+    }
+};
+
+TEST_F(EeconfigRecords, InitialisedAsValid) {
+    EXPECT_TRUE(eeconfig_is_kb_datablock_valid());
+    EXPECT_TRUE(eeconfig_is_user_datablock_valid());
+    EXPECT_EQ(read_kb(), kb_data_t{});
+}
+
+TEST_F(EeconfigRecords, UpdateSurvivesReload) {
+    kb_data_t data = make_data(0x10);
+    eeconfig_update_kb_datablock(data.data());
+    EXPECT_EQ(read_kb(), data);
+
+    eeconfig_load();
+    EXPECT_TRUE(eeconfig_is_kb_datablock_valid());
+    EXPECT_EQ(read_kb(), data);
+}
+
+TEST_F(EeconfigRecords, UpdatesAlternateCopies) {
+    kb_data_t first  = make_data(0x20);
+    kb_data_t second = make_data(0x30);
+    eeconfig_update_kb_datablock(first.data());
+    eeconfig_update_kb_datablock(second.data());
+    EXPECT_NE(find_copy(first), find_copy(second));
+}
+
+TEST_F(EeconfigRecords, CorruptNewestFallsBackToPrevious) {
+    kb_data_t first  = make_data(0x20);
+    kb_data_t second = make_data(0x30);
+    eeconfig_update_kb_datablock(first.data());
+    eeconfig_update_kb_datablock(second.data());
+
+    corrupt(kb_copy(find_copy(second)) + 3);
+    eeconfig_load();
+    EXPECT_TRUE(eeconfig_is_kb_datablock_valid());
+    EXPECT_EQ(read_kb(), first);
+
+    // The next update replaces the bad copy rather than the good one
+    kb_data_t third = make_data(0x40);
+    eeconfig_update_kb_datablock(third.data());
+    eeconfig_load();
+    EXPECT_EQ(read_kb(), third);
+    EXPECT_EQ(find_copy(first), find_copy(third) ^ 1);
+}
+
+TEST_F(EeconfigRecords, InterruptedWriteKeepsPrevious) {
+    kb_data_t first = make_data(0x50);
+    eeconfig_update_kb_datablock(first.data());
+    uint8_t spare = find_copy(first) ^ 1;
+
+    // Power lost half way through writing the next update
+    kb_data_t second = make_data(0x60);
+    eeprom_update_block(second.data(), kb_copy(spare), second.size() / 2);
+
+    eeconfig_load();
+    EXPECT_TRUE(eeconfig_is_kb_datablock_valid());
+    EXPECT_EQ(read_kb(), first);
+}
+
+TEST_F(EeconfigRecords, BothCopiesCorruptIsInvalid) {
+    kb_data_t first = make_data(0x70);
+    eeconfig_update_kb_datablock(first.data());
+    corrupt(kb_copy(0) + EECONFIG_KB_DATA_SIZE + 5);
+    corrupt(kb_copy(1) + 1);
+
+    eeconfig_load();
+    EXPECT_FALSE(eeconfig_is_kb_datablock_valid());
+    EXPECT_EQ(read_kb(), kb_data_t{});
+    EXPECT_TRUE(eeconfig_is_user_datablock_valid()) << "Records should be validated independently";
+
+    eeconfig_update_kb_datablock(first.data());
+    eeconfig_load();
+    EXPECT_TRUE(eeconfig_is_kb_datablock_valid());
+    EXPECT_EQ(read_kb(), first);
+}
+
+TEST_F(EeconfigRecords, VersionMismatchIsInvalid) {
+    // Rewrite the version of both copies, fixing up the CRC so only the version is wrong
+    for (uint8_t copy = 0; copy < 2; copy++) {
+        uint8_t image[KB_COPY_SIZE];
+        eeprom_read_block(image, kb_copy(copy), sizeof(image));
+        image[EECONFIG_KB_DATA_SIZE] ^= 0x01;
+        image[KB_COPY_SIZE - 1] = crc8(image, KB_COPY_SIZE - 1);
+        eeprom_update_block(image, kb_copy(copy), sizeof(image));
+    }
+
+    eeconfig_load();
+    EXPECT_FALSE(eeconfig_is_kb_datablock_valid());
+}
+
+TEST_F(EeconfigRecords, SequenceWrapsAround) {
+    for (int i = 0; i < 600; i++) {
+        kb_data_t data = make_data(i);
+        eeconfig_update_kb_datablock(data.data());
+        if (i % 7 == 0) {
+            eeconfig_load();
+            ASSERT_EQ(read_kb(), data) << "after update " << i;
+        }
+    }
+}
+
+TEST_F(EeconfigRecords, CoreSettingsReadFromRam) {
+    uint16_t keymap = eeconfig_read_keymap();
+    eeconfig_update_keymap(keymap ^ 0x0001);
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), keymap ^ 0x0001);
+
+    // Changes behind eeconfig's back are only seen after a reload
+    eeprom_update_word(EECONFIG_KEYMAP, keymap ^ 0x0002);
+    EXPECT_EQ(eeconfig_read_keymap(), keymap ^ 0x0001);
+    eeconfig_load();
+    EXPECT_EQ(eeconfig_read_keymap(), keymap ^ 0x0002);
+
+    eeconfig_update_keymap(keymap);
+}
@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+EEPROM_DRIVER = transient
+EEPROM_STATS_ENABLE = yes
+DYNAMIC_KEYMAP_ENABLE = yes
@@ -0,0 +1,84 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom_driver.h"
+#include "dynamic_keymap.h"
+}
+
+class EepromStats : public TestFixture {
+   public:
+    const eeprom_stats_t *stats;
+
+    void SetUp() override {
+        eeprom_stats_reset();
+        stats = eeprom_stats_get();
+    }
+
+    uint32_t total_written(void) {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < EEPROM_REGION_COUNT; i++) {
+            total += stats->bytes_written[i];
+        }
+        return total;
+    }
+};
+
+TEST_F(EepromStats, EeconfigWritesAttributedToEeconfig) {
+    uint16_t keymap = eeconfig_read_keymap();
+    EXPECT_EQ(stats->bytes_read[EEPROM_REGION_EECONFIG], 2);
+
+    eeconfig_update_keymap(keymap ^ 0x0001);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_EECONFIG], 2);
+    EXPECT_EQ(total_written(), 2);
+
+    eeconfig_update_keymap(keymap);
+}
+
+TEST_F(EepromStats, DatablocksAttributedSeparately) {
+    uint8_t kb_data[EECONFIG_KB_DATA_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8};
+    eeconfig_update_kb_datablock(kb_data);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_KB_DATABLOCK], EECONFIG_KB_DATA_SIZE);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_USER_DATABLOCK], 0);
+
+    uint8_t user_data[EECONFIG_USER_DATA_SIZE] = {9, 10, 11, 12};
+    eeconfig_update_user_datablock(user_data);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_USER_DATABLOCK], EECONFIG_USER_DATA_SIZE);
+}
+
+TEST_F(EepromStats, DynamicKeymapAndMacrosAttributedSeparately) {
+    dynamic_keymap_set_keycode(1, 0, 0, LCTL(KC_B));
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_DYNAMIC_KEYMAP], 2);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_MACROS], 0);
+
+    uint8_t macro[] = {'a', 'b'};
+    dynamic_keymap_macro_set_buffer(0, sizeof(macro), macro);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_MACROS], sizeof(macro));
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_DYNAMIC_KEYMAP], 2);
+    EXPECT_EQ(stats->bytes_written[EEPROM_REGION_OTHER], 0);
+
+    dynamic_keymap_reset();
+    dynamic_keymap_macro_reset();
+}
+
+TEST_F(EepromStats, AccessSpanningRegionsIsSplit) {
+    uint8_t buf[4];
+    eeprom_read_block(buf, (void *)(EECONFIG_BASE_SIZE - 2), sizeof(buf));
+    EXPECT_EQ(stats->bytes_read[EEPROM_REGION_EECONFIG], 2);
+    EXPECT_EQ(stats->bytes_read[EEPROM_REGION_KB_DATABLOCK], 2);
+
+    eeprom_read_block(buf, (void *)(TRANSIENT_EEPROM_SIZE - sizeof(buf)), sizeof(buf));
+    EXPECT_EQ(stats->bytes_read[EEPROM_REGION_MACROS], sizeof(buf));
+}
+
+TEST_F(EepromStats, ResetClearsCounters) {
+    eeconfig_read_keymap();
+    eeprom_stats_reset();
+    for (uint8_t i = 0; i < EEPROM_REGION_COUNT; i++) {
+        EXPECT_EQ(stats->bytes_read[i], 0);
+        EXPECT_EQ(stats->bytes_written[i], 0);
+    }
+}
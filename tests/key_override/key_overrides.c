@@ -0,0 +1,35 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Overrides only active on layer 1, standing in for the many overrides of a heavily customised keymap
+#define FILLER_OVERRIDES 240
+
+static key_override_t filler_overrides[FILLER_OVERRIDES];
+
+// clang-format off
+static const key_override_t ctrl_shift_q_override = ko_make_basic(MOD_MASK_CS, KC_Q, KC_E);
+static const key_override_t shift_q_override      = ko_make_basic(MOD_MASK_SHIFT, KC_Q, KC_W);
+static const key_override_t rctl_r_override       = ko_make_basic(MOD_BIT(KC_RCTL), KC_R, KC_T);
+static const key_override_t rctl_override         = ko_make_basic(MOD_BIT(KC_RCTL), KC_NO, KC_Y);
+static const key_override_t shift_bspc_override   = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+// clang-format on
+
+static const key_override_t *test_key_overrides[FILLER_OVERRIDES + 6];
+
+void setup_test_key_overrides(void) {
+    uint16_t i = 0;
+    for (; i < FILLER_OVERRIDES; i++) {
+        filler_overrides[i]   = ko_make_with_layers(MOD_MASK_SHIFT, KC_A + (i % 26), KC_1 + (i % 10), 1 << 1);
+        test_key_overrides[i] = &filler_overrides[i];
+    }
+    test_key_overrides[i++] = &ctrl_shift_q_override;
+    test_key_overrides[i++] = &shift_q_override;
+    test_key_overrides[i++] = &rctl_r_override;
+    test_key_overrides[i++] = &rctl_override;
+    test_key_overrides[i++] = &shift_bspc_override;
+    test_key_overrides[i]   = NULL;
+
+    key_overrides = test_key_overrides;
+}
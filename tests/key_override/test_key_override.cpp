@@ -0,0 +1,179 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+extern "C" void setup_test_key_overrides(void);
+
+class KeyOverride : public TestFixture {
+   public:
+    void SetUp() override {
+        setup_test_key_overrides();
+    }
+};
+
+TEST_F(KeyOverride, override_at_end_of_large_table_activates) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_bspc = KeymapKey(0, 1, 0, KC_BSPC);
+
+    set_keymap({key_lsft, key_bspc});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_DEL));
+    key_bspc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_bspc.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, override_on_other_layer_does_not_activate) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_a    = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_lsft, key_a});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    key_a.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_a.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, earlier_override_for_same_trigger_wins) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_lctl = KeymapKey(0, 0, 0, KC_LCTL);
+    auto       key_lsft = KeymapKey(0, 1, 0, KC_LSFT);
+    auto       key_q    = KeymapKey(0, 2, 0, KC_Q);
+
+    set_keymap({key_lctl, key_lsft, key_q});
+
+    EXPECT_REPORT(driver, (KC_LCTL));
+    key_lctl.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+    key_lsft.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_E));
+    key_q.press();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT));
+    key_q.release();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_lctl.release();
+    run_one_scan_loop();
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, trigger_override_defined_before_mods_only_override_wins) {
+    TestDriver driver;
+    auto       key_rctl = KeymapKey(0, 0, 0, KC_RCTL);
+    auto       key_r    = KeymapKey(0, 1, 0, KC_R);
+
+    set_keymap({key_rctl, key_r});
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_Y)).Times(0);
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_R));
+        EXPECT_REPORT(driver, (KC_T));
+    }
+    key_r.press();
+    run_one_scan_loop();
+    key_rctl.press();
+    run_one_scan_loop();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_Y)).Times(0);
+    key_r.release();
+    run_one_scan_loop();
+    key_rctl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Host benchmark of key override lookup: times process_key_override() against a table of
+// 245 overrides for shifted keys whose overrides are all on another layer, so none activate.
+// key_override_no_index builds this file again to time the same lookup with a full scan.
+TEST_F(KeyOverride, benchmark_large_table) {
+    TestDriver driver;
+    auto       key_a      = KeymapKey(0, 0, 0, KC_A);
+    const int  iterations = 20000;
+
+    set_keymap({key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    add_mods(MOD_BIT(KC_LSFT));
+
+    keyrecord_t press     = {};
+    press.event.type      = KEY_EVENT;
+    press.event.pressed   = true;
+    keyrecord_t release   = press;
+    release.event.pressed = false;
+    bool send             = true;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        const uint16_t keycode = KC_A + (i % 16); // KC_A to KC_P, only filler overrides
+        send &= process_key_override(keycode, &press);
+        send &= process_key_override(keycode, &release);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    del_mods(MOD_BIT(KC_LSFT));
+
+    EXPECT_TRUE(send);
+
+    const double ns_per_event = static_cast<double>(elapsed.count()) / (2 * iterations);
+    RecordProperty("ns_per_event", static_cast<int>(ns_per_event));
+    std::cout << "[ BENCHMARK] process_key_override: " << ns_per_event << " ns per key event" << std::endl;
+
+    VERIFY_AND_CLEAR(driver);
+}
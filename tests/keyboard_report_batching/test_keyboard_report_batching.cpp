@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class KeyboardReportBatching : public TestFixture {};
+
+TEST_F(KeyboardReportBatching, chord_in_one_scan_sends_one_report) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C)).Times(1);
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(1);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardReportBatching, modifiers_are_sent_before_keys) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_ctrl  = KeymapKey(0, 1, 0, KC_LCTL);
+    auto       key_a     = KeymapKey(0, 2, 0, KC_A);
+    auto       key_b     = KeymapKey(0, 3, 0, KC_B);
+
+    set_keymap({key_shift, key_ctrl, key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_LSFT, KC_LCTL));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_LCTL, KC_A, KC_B));
+    key_shift.press();
+    key_ctrl.press();
+    key_a.press();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    key_ctrl.release();
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardReportBatching, key_press_before_modifier_release_keeps_order) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto       key_shift = KeymapKey(0, 1, 0, KC_LSFT);
+
+    set_keymap({key_a, key_shift});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardReportBatching, tap_within_one_scan_is_not_lost) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_mod_tap = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+
+    set_keymap({key_mod_tap});
+
+    EXPECT_NO_REPORT(driver);
+    key_mod_tap.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    key_mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardReportBatching, caps_lock_tap_is_held_for_the_caps_delay) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_mod_tap = KeymapKey(0, 0, 0, LSFT_T(KC_CAPS));
+    uint32_t   pressed_at  = 0;
+    uint32_t   released_at = 0;
+
+    set_keymap({key_mod_tap});
+
+    EXPECT_NO_REPORT(driver);
+    key_mod_tap.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_CAPS)).WillOnce([&](report_keyboard_t &) { pressed_at = timer_read32(); });
+    EXPECT_EMPTY_REPORT(driver).WillOnce([&](report_keyboard_t &) { released_at = timer_read32(); });
+    key_mod_tap.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_GE(released_at - pressed_at, TAP_HOLD_CAPS_DELAY);
+}
+
+TEST_F(KeyboardReportBatching, modifier_is_sent_before_mouse_button) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_btn1  = KeymapKey(0, 1, 0, KC_MS_BTN1);
+
+    set_keymap({key_shift, key_btn1});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_CALL(driver, send_mouse_mock(_)).With(testing::Truly([](const std::tuple<report_mouse_t &> &args) { return std::get<0>(args).buttons == 1; }));
+    key_shift.press();
+    key_btn1.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_mouse_mock(_)).With(testing::Truly([](const std::tuple<report_mouse_t &> &args) { return std::get<0>(args).buttons == 0; }));
+    key_shift.release();
+    key_btn1.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardReportBatching, modifier_is_sent_before_consumer_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LSFT);
+    auto       key_volu  = KeymapKey(0, 1, 0, KC_VOLU);
+
+    set_keymap({key_shift, key_volu});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_CALL(driver, send_extra_mock(_)).With(testing::Truly([](const std::tuple<report_extra_t &> &args) { return std::get<0>(args).usage == AUDIO_VOL_UP; }));
+    key_shift.press();
+    key_volu.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(_)).With(testing::Truly([](const std::tuple<report_extra_t &> &args) { return std::get<0>(args).usage == 0; }));
+    key_shift.release();
+    key_volu.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
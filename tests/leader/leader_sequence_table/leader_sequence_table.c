@@ -0,0 +1,26 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+uint8_t leader_callback_count = 0;
+
+static void leader_callback(void) {
+    leader_callback_count++;
+}
+
+// Deliberately out of order, the table is sorted when the leader key is first used
+const leader_sequence_t leader_sequences[] PROGMEM = {
+    LEADER_SEQUENCE_KEYCODE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE_CALLBACK(leader_callback, KC_C, KC_D),
+    LEADER_SEQUENCE_KEYCODE(KC_1, KC_A),
+    LEADER_SEQUENCE_STRING("ab", KC_E),
+    LEADER_SEQUENCE_KEYCODE(KC_3, KC_F),
+    LEADER_SEQUENCE_KEYCODE(KC_4, KC_F),
+};
+
+void leader_end_user(void) {
+    if (leader_sequence_one_key(KC_X)) {
+        tap_code(KC_9);
+    }
+}
@@ -0,0 +1,145 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+extern "C" uint8_t leader_callback_count;
+
+class LeaderSequenceTable : public TestFixture {};
+
+TEST_F(LeaderSequenceTable, prefix_of_longer_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_leader, key_a});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequenceTable, unique_sequence_ends_without_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto key_b      = KeymapKey(0, 2, 0, KC_B);
+
+    set_keymap({key_leader, key_a, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+}
+
+TEST_F(LeaderSequenceTable, invokes_callback) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_c      = KeymapKey(0, 1, 0, KC_C);
+    auto key_d      = KeymapKey(0, 2, 0, KC_D);
+
+    set_keymap({key_leader, key_c, key_d});
+
+    leader_callback_count = 0;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_c);
+    tap_key(key_d);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_callback_count, 1);
+}
+
+TEST_F(LeaderSequenceTable, sends_string) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_e      = KeymapKey(0, 1, 0, KC_E);
+
+    set_keymap({key_leader, key_e});
+
+    testing::InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_e);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderSequenceTable, first_duplicate_wins) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_f      = KeymapKey(0, 1, 0, KC_F);
+
+    set_keymap({key_leader, key_f});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_f);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+}
+
+TEST_F(LeaderSequenceTable, unknown_sequence_falls_back_to_callback) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_c      = KeymapKey(0, 1, 0, KC_C);
+    auto key_x      = KeymapKey(0, 2, 0, KC_X);
+
+    set_keymap({key_leader, key_c, key_x});
+
+    leader_callback_count = 0;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_c);
+    tap_key(key_x);
+    idle_for(300);
+
+    EXPECT_EQ(leader_callback_count, 0);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_x);
+    idle_for(300);
+}
@@ -0,0 +1,190 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   public:
+    void type_until_done(unsigned limit = 1000) {
+        while (send_string_is_busy() && limit-- > 0) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_is_busy());
+    }
+};
+
+static void count_completion(void *context) {
+    (*(int *)context)++;
+}
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_enqueue("ab", 0, 0, NULL, NULL));
+    EXPECT_TRUE(send_string_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    type_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, OneReportPerLoop) {
+    TestDriver driver;
+    InSequence s;
+
+    SEND_STRING_ASYNC("A");
+
+    // Decode
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    type_until_done();
+}
+
+TEST_F(SendStringAsync, BlockingTypesBeforeReturning) {
+    TestDriver driver;
+    InSequence s;
+    int        completions = 0;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(send_string_enqueue(PSTR("ab"), 0, SEND_STRING_FLAG_PROGMEM | SEND_STRING_FLAG_BLOCKING, count_completion, &completions));
+    EXPECT_FALSE(send_string_is_busy());
+    EXPECT_EQ(completions, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CallbackAfterLastReport) {
+    TestDriver driver;
+    int        completions = 0;
+
+    EXPECT_ANY_REPORT(driver).Times(4);
+    send_string_enqueue("ab", 0, 0, count_completion, &completions);
+    send_string_enqueue("", 0, 0, count_completion, &completions);
+
+    while (send_string_is_busy()) {
+        EXPECT_EQ(completions, 0);
+        run_one_scan_loop();
+        if (completions > 0) {
+            break;
+        }
+    }
+    EXPECT_EQ(completions, 1);
+    type_until_done();
+    EXPECT_EQ(completions, 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, StringsTypedInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_enqueue("a", 0, 0, NULL, NULL);
+    send_string_enqueue("b", 0, 0, NULL, NULL);
+    send_string_enqueue("c", 0, 0, NULL, NULL);
+    type_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, FullQueueRejected) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(2 * 15);
+    // 15 characters and a terminator fill the queue
+    EXPECT_TRUE(send_string_enqueue("abcdefghijklmno", 0, 0, NULL, NULL));
+    EXPECT_FALSE(send_string_enqueue("p", 0, 0, NULL, NULL));
+    type_until_done();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(2 * SEND_STRING_QUEUE_ENTRIES);
+    for (int i = 0; i < SEND_STRING_QUEUE_ENTRIES; i++) {
+        EXPECT_TRUE(send_string_enqueue("a", 0, 0, NULL, NULL));
+    }
+    EXPECT_FALSE(send_string_enqueue("a", 0, 0, NULL, NULL)) << "Should have run out of entries";
+    type_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, TooLongFallsBackWhenBlocking) {
+    TestDriver driver;
+    int        completions = 0;
+
+    EXPECT_FALSE(send_string_enqueue("abcdefghijklmnop", 0, 0, NULL, NULL));
+
+    EXPECT_ANY_REPORT(driver).Times(2 * 16);
+    EXPECT_TRUE(send_string_enqueue("abcdefghijklmnop", 0, SEND_STRING_FLAG_BLOCKING, count_completion, &completions));
+    EXPECT_EQ(completions, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DelayAndIntervalHonoured) {
+    TestDriver driver;
+    InSequence s;
+
+    send_string_enqueue("a" SS_DELAY(100) "b", 10, 0, NULL, NULL);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    type_until_done();
+}
+
+TEST_F(SendStringAsync, TapDownUpCodes) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING_ASYNC(SS_DOWN(X_LCTL) SS_TAP(X_C) SS_UP(X_LCTL));
+    type_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define PERMISSIVE_HOLD
+#define TAP_HOLD_PREDICTION
+#define TAP_HOLD_PREDICTION_PER_KEY
@@ -0,0 +1,441 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+
+static bool prediction_enabled = true;
+
+extern "C" bool get_tap_hold_prediction(uint16_t keycode, keyrecord_t *record) {
+    return prediction_enabled;
+}
+
+static std::map<uint16_t, int> user_releases;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        user_releases[keycode]++;
+    }
+    return true;
+}
+
+class TapHoldPrediction : public TestFixture {
+   public:
+    void SetUp() override {
+        prediction_enabled = true;
+        user_releases.clear();
+        tap_hold_prediction_clear();
+    }
+
+    /* Press a key, release it after hold ms, and wait until gap ms after the press. */
+    void type(KeymapKey &key, unsigned hold, unsigned gap) {
+        key.press();
+        run_one_scan_loop();
+        idle_for(hold - 1);
+        key.release();
+        run_one_scan_loop();
+        idle_for(gap - hold - 1);
+    }
+
+    /* Type at a steady rhythm, tapping the mod-tap key every third key. */
+    void train(KeymapKey &mod_tap_key, KeymapKey &regular_key) {
+        for (int i = 0; i < 6; i++) {
+            type(regular_key, 50, 100);
+            type(regular_key, 50, 100);
+            type(mod_tap_key, 60, 100);
+        }
+    }
+};
+
+TEST_F(TapHoldPrediction, roll_waits_for_release_without_statistics) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    /* Press mod-tap key, then regular key */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(30);
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap key */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_P, KC_A));
+    EXPECT_REPORT(driver, (KC_A));
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release regular key */
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapHoldPrediction, roll_resolves_on_next_press_once_trained) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    train(mod_tap_key, regular_key);
+    type(regular_key, 50, 100);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+
+    /* Press mod-tap key mid-streak */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Press regular key: the mod-tap key is a tap */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_P, KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap key */
+    EXPECT_REPORT(driver, (KC_A));
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release regular key */
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapHoldPrediction, deliberate_hold_is_not_predicted) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    train(mod_tap_key, regular_key);
+    type(regular_key, 50, 100);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+
+    /* Press mod-tap key and hold it for longer than it is usually tapped */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(100);
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release regular key */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap key */
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapHoldPrediction, disabled_per_key) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_key = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    train(mod_tap_key, regular_key);
+    type(regular_key, 50, 100);
+    VERIFY_AND_CLEAR(driver);
+
+    prediction_enabled = false;
+
+    /* Press mod-tap key mid-streak, then regular key */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(30);
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    mod_tap_key.release();
+    run_one_scan_loop();
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapHoldPrediction, roll_across_two_mod_taps) {
+    TestDriver driver;
+    auto       first_mod_tap  = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       second_mod_tap = KeymapKey(0, 3, 0, CTL_T(KC_O));
+    auto       regular_key    = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({first_mod_tap, second_mod_tap, regular_key});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    train(first_mod_tap, regular_key);
+    type(regular_key, 50, 100);
+    VERIFY_AND_CLEAR(driver);
+
+    InSequence s;
+
+    /* Press first mod-tap key mid-streak */
+    EXPECT_NO_REPORT(driver);
+    first_mod_tap.press();
+    run_one_scan_loop();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Roll onto second mod-tap key: the first is a predicted tap, released as the second takes over */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    second_mod_tap.press();
+    run_one_scan_loop();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release first mod-tap key */
+    EXPECT_NO_REPORT(driver);
+    first_mod_tap.release();
+    run_one_scan_loop();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release second mod-tap key */
+    EXPECT_REPORT(driver, (KC_O));
+    EXPECT_EMPTY_REPORT(driver);
+    second_mod_tap.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapHoldPrediction, tapped_key_is_released_once_when_next_mod_tap_is_pressed) {
+    TestDriver driver;
+    InSequence s;
+    auto       first_mod_tap  = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       second_mod_tap = KeymapKey(0, 3, 0, CTL_T(KC_O));
+
+    set_keymap({first_mod_tap, second_mod_tap});
+
+    /* Tap first mod-tap key */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    first_mod_tap.press();
+    run_one_scan_loop();
+    idle_for(30);
+    first_mod_tap.release();
+    run_one_scan_loop();
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Tap second mod-tap key within the tapping term */
+    EXPECT_REPORT(driver, (KC_O));
+    EXPECT_EMPTY_REPORT(driver);
+    second_mod_tap.press();
+    run_one_scan_loop();
+    idle_for(30);
+    second_mod_tap.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(user_releases[SFT_T(KC_P)], 1);
+    EXPECT_EQ(user_releases[CTL_T(KC_O)], 1);
+}
+
+/* Replays generated typing, with rolls over a home row mod and the odd
+ * deliberately shifted letter, and measures how long each key takes to reach
+ * the host and how many words come out wrong.
+ */
+class TapHoldPredictionReplay : public TapHoldPrediction {
+   public:
+    struct Event {
+        uint32_t time;
+        size_t   key;
+        bool     pressed;
+        bool     typed; // expected to reach the host as this key's keycode
+    };
+
+    struct Result {
+        double   latency;
+        unsigned held_back; // keys that reached the host later than the scan they were pressed in
+        double   misfire_rate;
+    };
+
+    std::vector<KeymapKey>   keys = {KeymapKey(0, 0, 0, SFT_T(KC_A)), KeymapKey(0, 1, 0, KC_S), KeymapKey(0, 2, 0, KC_D), KeymapKey(0, 3, 0, KC_E), KeymapKey(0, 4, 0, KC_R), KeymapKey(0, 5, 0, KC_T), KeymapKey(0, 6, 0, KC_SPACE)};
+    std::vector<Event>       events;
+    std::vector<std::string> words;
+
+    uint32_t seed = 1;
+
+    unsigned random(unsigned low, unsigned high) {
+        seed = seed * 1103515245 + 12345;
+        return low + (seed >> 16) % (high - low + 1);
+    }
+
+    char letter(size_t key) {
+        return key == 6 ? ' ' : "asdert"[key];
+    }
+
+    void generate(int word_count) {
+        uint32_t t          = 1000;
+        uint32_t free_at[7] = {};
+
+        // Press and release a key, no earlier than it was last released
+        auto stroke = [&](size_t key, unsigned hold, bool typed) {
+            t = std::max(t, free_at[key] + 10);
+            events.push_back({t, key, true, typed});
+            events.push_back({t + hold, key, false, false});
+            free_at[key] = t + hold;
+        };
+
+        for (int w = 0; w < word_count; w++) {
+            std::string word;
+            int         length = random(3, 6);
+            for (int i = 0; i < length; i++) {
+                size_t key = random(0, 3) == 0 ? 0 : random(1, 5);
+                if (i == 0 && key != 0 && random(0, 4) == 0) {
+                    // Deliberately shifted letter
+                    t              = std::max(t, free_at[0] + 10);
+                    uint32_t shift = t;
+                    t += random(100, 180);
+                    stroke(key, random(50, 100), true);
+                    events.push_back({shift, 0, true, false});
+                    events.push_back({free_at[key] + 20, 0, false, false});
+                    free_at[0] = free_at[key] + 20;
+                    t          = free_at[0] + random(50, 120);
+                    word += toupper(letter(key));
+                } else {
+                    stroke(key, random(50, 100), true);
+                    t += random(50, 120);
+                    word += letter(key);
+                }
+            }
+            stroke(6, random(50, 100), true);
+            t += random(50, 120);
+            words.push_back(word);
+        }
+        std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.time < b.time; });
+    }
+
+    Result replay(TestDriver &driver) {
+        std::map<uint8_t, std::deque<uint32_t>> pending;
+        std::string                             output;
+        std::vector<uint8_t>                    previous;
+        uint32_t                                total_latency = 0;
+        unsigned                                measured      = 0;
+        unsigned                                held_back     = 0;
+        uint32_t                                start         = timer_read32();
+
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            std::vector<uint8_t> current;
+            for (uint8_t code : report.keys) {
+                if (code == KC_NO) continue;
+                current.push_back(code);
+                if (std::find(previous.begin(), previous.end(), code) != previous.end()) continue;
+
+                char c = code == KC_SPACE ? ' ' : 'a' + (code - KC_A);
+                output += (report.mods & MOD_BIT(KC_LEFT_SHIFT)) ? toupper(c) : c;
+                if (!pending[code].empty()) {
+                    uint32_t latency = timer_read32() - start - pending[code].front();
+                    total_latency += latency;
+                    held_back += latency > 0;
+                    pending[code].pop_front();
+                    measured++;
+                }
+            }
+            previous = current;
+        }));
+
+        auto     next = events.begin();
+        uint32_t end  = events.back().time + 500;
+        for (uint32_t t = 0; t < end; t++) {
+            for (; next != events.end() && next->time == t; ++next) {
+                KeymapKey &key = keys[next->key];
+                if (next->pressed) {
+                    key.press();
+                    if (next->typed) {
+                        pending[key.report_code].push_back(t);
+                    }
+                } else {
+                    key.release();
+                }
+            }
+            run_one_scan_loop();
+        }
+        VERIFY_AND_CLEAR(driver);
+
+        std::istringstream typed(output);
+        std::string        word;
+        unsigned           wrong = 0;
+        for (const std::string &expected : words) {
+            if (!(typed >> word) || word != expected) wrong++;
+        }
+        return {static_cast<double>(total_latency) / measured, held_back, static_cast<double>(wrong) / words.size()};
+    }
+};
+
+TEST_F(TapHoldPredictionReplay, measure_latency_and_misfires) {
+    TestDriver driver;
+
+    set_keymap({keys[0], keys[1], keys[2], keys[3], keys[4], keys[5], keys[6]});
+    generate(200);
+
+    prediction_enabled = false;
+    Result baseline    = replay(driver);
+
+    tap_hold_prediction_clear();
+    prediction_enabled = true;
+    Result predicted   = replay(driver);
+
+    RecordProperty("baseline_latency_ms", static_cast<int>(baseline.latency * 1000));
+    RecordProperty("predicted_latency_ms", static_cast<int>(predicted.latency * 1000));
+    std::cout << "[    REPLAY] latency " << baseline.latency << " ms -> " << predicted.latency << " ms, keys held back " << baseline.held_back << " -> " << predicted.held_back << ", misfires " << baseline.misfire_rate * 100 << "% -> " << predicted.misfire_rate * 100 << "% of words" << std::endl;
+
+    EXPECT_LT(predicted.latency, baseline.latency);
+    EXPECT_LT(predicted.held_back, baseline.held_back);
+    EXPECT_LE(predicted.misfire_rate, baseline.misfire_rate);
+}
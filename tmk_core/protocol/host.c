@@ -40,10 +40,27 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 extern keymap_config_t keymap_config;
 #endif
 
+#ifdef BOOT_PROFILE_ENABLE
+#    include "boot_profile.h"
+#endif
+
+#ifdef KEYBOARD_REPORT_BATCHING
+#    include "action_util.h"
+#endif
+
 static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+/* Keyboard reports held back by a batch must reach the host before any
+ * other report, or e.g. a modifier would arrive after the click it applies to.
+ */
+static inline void flush_keyboard_report_batch(void) {
+#ifdef KEYBOARD_REPORT_BATCHING
+    keyboard_report_batch_flush();
+#endif
+}
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
 }
@@ -85,6 +102,9 @@ void host_keyboard_send(report_keyboard_t *report) {
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
     (*driver->send_keyboard)(report);
+#ifdef BOOT_PROFILE_ENABLE
+    boot_profile_mark(BOOT_PHASE_FIRST_REPORT);
+#endif
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -110,6 +130,8 @@ void host_nkro_send(report_nkro_t *report) {
 }
 
 void host_mouse_send(report_mouse_t *report) {
+    flush_keyboard_report_batch();
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_mouse(report);
@@ -132,6 +154,7 @@ void host_mouse_send(report_mouse_t *report) {
 void host_system_send(uint16_t usage) {
     if (usage == last_system_usage) return;
     last_system_usage = usage;
+    flush_keyboard_report_batch();
 
     if (!driver) return;
 
@@ -145,6 +168,7 @@ void host_system_send(uint16_t usage) {
 void host_consumer_send(uint16_t usage) {
     if (usage == last_consumer_usage) return;
     last_consumer_usage = usage;
+    flush_keyboard_report_batch();
 
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
@@ -165,6 +189,7 @@ void host_consumer_send(uint16_t usage) {
 #ifdef JOYSTICK_ENABLE
 void host_joystick_send(joystick_t *joystick) {
     if (!driver) return;
+    flush_keyboard_report_batch();
 
     report_joystick_t report = {
 #    ifdef JOYSTICK_SHARED_EP
@@ -219,6 +244,8 @@ __attribute__((weak)) void send_joystick(report_joystick_t *report) {}
 
 #ifdef DIGITIZER_ENABLE
 void host_digitizer_send(digitizer_t *digitizer) {
+    flush_keyboard_report_batch();
+
     report_digitizer_t report = {
 #    ifdef DIGITIZER_SHARED_EP
         .report_id = REPORT_ID_DIGITIZER,
@@ -238,6 +265,8 @@ __attribute__((weak)) void send_digitizer(report_digitizer_t *report) {}
 
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
 void host_programmable_button_send(uint32_t data) {
+    flush_keyboard_report_batch();
+
     report_programmable_button_t report = {
         .report_id = REPORT_ID_PROGRAMMABLE_BUTTON,
         .usage     = data,